@@ -1,10 +1,13 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <initializer_list>
 #include <utility>
 
-#include "aisdi/HashMap.hpp"
+#include "aisdi/CowVector.hpp"
+#include "aisdi/HashSet.hpp"
+#include "aisdi/IntegerHashMap.hpp"
 #include "aisdi/List.hpp"
 #include "aisdi/Vector.hpp"
 
@@ -24,7 +27,8 @@ public:
 
 	struct Vertex
 	{
-		using Adjacents = aisdi::Vector<VertexDescriptor>;
+		// Copy-on-write, so copies of vertices are cheap snapshots
+		using Adjacents = aisdi::CowVector<VertexDescriptor>;
 
 		Adjacents adjacents;
 
@@ -40,10 +44,8 @@ public:
 
 		void remove_adjacent(VertexDescriptor u)
 		{
-			adjacents.erase(std::remove(adjacents.begin(),
-								        adjacents.end(),
-								        u),
-					        adjacents.end());
+			// Order of adjacents is irrelevant, so each removal is O(1)
+			adjacents.remove_value_unordered(u);
 		}
 
 		std::size_t degree() const
@@ -58,7 +60,18 @@ public:
 		VertexDescriptor v;
 	};
 
-	using Vertices = aisdi::HashMap<VertexDescriptor, Vertex>;
+	// Descriptors are plain integers, so they are kept in a flat array probed
+	// with SIMD compares, apart from the array of vertices. Lookups do not
+	// touch vertices, until the descriptor is found. Descriptors are mostly
+	// consecutive, so they are spread with Fibonacci hashing, as in VertexSet.
+	template<typename T>
+	using VertexMap = aisdi::IntegerHashMap<VertexDescriptor, T>;
+
+	using Vertices = VertexMap<Vertex>;
+	using VertexSet = aisdi::HashSet<VertexDescriptor,
+									 std::hash<VertexDescriptor>,
+									 std::equal_to<VertexDescriptor>,
+									 aisdi::FibonacciBucketPolicy>;
 	using VertexIterator = Vertices::const_iterator;
 	using Edges = aisdi::List<Edge>;
 	using EdgeIterator = Edges::const_iterator;
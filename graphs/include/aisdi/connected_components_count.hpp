@@ -5,28 +5,21 @@
 
 namespace aisdi {
 
-namespace {
-
-struct DummyType {};
-
-} //
-
 inline std::size_t connected_components_count(const Graph& graph)
 {
 	std::size_t count = 0;
 	aisdi::Vector<Graph::VertexDescriptor> stack;
-	aisdi::HashMap<Graph::VertexDescriptor, DummyType> visited;
+	Graph::VertexSet visited;
 
 	const auto vertices = graph.vertices();
 	for(auto vertex_pos = vertices.first; vertex_pos != vertices.last; ++vertex_pos)
 	{
 		const auto u = vertex_pos->first;
-		if(visited.contains(u))
+		if(!visited.insert(u).second)
 		{
 			continue;
 		}
 
-		visited[u] = {};
 		stack.append(u);
 
 		while(!stack.empty())
@@ -35,12 +28,12 @@ inline std::size_t connected_components_count(const Graph& graph)
 			const auto& target = graph.get_vertex(v);
 			for(const auto k : target.adjacents)
 			{
-				if(visited.contains(k))
+				// Marks k as visited with the same lookup, which checks it
+				if(!visited.insert(k).second)
 				{
 					continue;
 				}
 
-				visited[k] = {};
 				stack.append(k);
 			}
 		}
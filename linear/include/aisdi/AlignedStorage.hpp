@@ -0,0 +1,160 @@
+#ifndef AISDI_ALIGNEDSTORAGE_HPP
+#define AISDI_ALIGNEDSTORAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "aisdi/util.hpp"
+
+#include "gsl/gsl_assert"
+
+namespace aisdi {
+
+// Storage policy of Vector, which buffer starts at Alignment boundary,
+// e.g. aisdi::Vector<float, AlignedStorage<float, 32>>.
+//
+// Capacity is padded, so buffer always spans whole Alignment sized blocks.
+// With Alignment equal to the width of vector registers (32 for AVX2,
+// 64 for a cache line) no vector load over the items is split between
+// two cache lines and the last block may be processed as a whole.
+template<typename T, std::size_t Alignment = 64>
+class AlignedStorage
+{
+	static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+		"Alignment has to be a power of two");
+	static_assert(Alignment >= alignof(T),
+		"Alignment cannot be weaker than natural alignment of items");
+
+public:
+	using size_type = std::size_t;
+
+	constexpr static size_type alignment = Alignment;
+
+	AlignedStorage() noexcept = default;
+
+	explicit AlignedStorage(size_type capacity)
+	{
+		if(capacity == 0)
+		{
+			return;
+		}
+
+		const auto bytes = padded(capacity) * sizeof(T);
+
+		// Over-allocated by Alignment, so the buffer may be moved forward
+		_memory.reset(new char[bytes + Alignment]);
+		const auto address = reinterpret_cast<std::uintptr_t>(_memory.get());
+		const auto aligned = (address + Alignment - 1) & ~std::uintptr_t{Alignment - 1};
+		_buffer = reinterpret_cast<T*>(aligned);
+
+		try
+		{
+			const auto count = bytes / sizeof(T);
+			for(; _capacity < count; ++_capacity)
+			{
+				new (_buffer + _capacity) T();
+			}
+		}
+		catch(...)
+		{
+			release();
+			throw;
+		}
+
+		// Postconditions
+		Ensures(_capacity >= capacity);
+		Ensures(reinterpret_cast<std::uintptr_t>(_buffer) % Alignment == 0);
+	}
+
+	AlignedStorage(AlignedStorage&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	AlignedStorage&
+	operator=(AlignedStorage&& other) noexcept
+	{
+		if(this != &other)
+		{
+			release();
+
+			_memory = std::move(other._memory);
+			_buffer = other._buffer;
+			_capacity = other._capacity;
+
+			other._buffer = nullptr;
+			other._capacity = 0;
+		}
+
+		return *this;
+	}
+
+	~AlignedStorage()
+	{
+		release();
+	}
+
+	T*
+	data() noexcept
+	{
+		return _buffer;
+	}
+
+	const T*
+	data() const noexcept
+	{
+		return _buffer;
+	}
+
+	size_type
+	capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	// Padding is already counted in capacity(), so there is nothing to grow into
+	bool
+	growInPlace(size_type) noexcept
+	{
+		return false;
+	}
+
+	bool
+	shrinkInPlace(size_type) noexcept
+	{
+		return false;
+	}
+
+private:
+	// Rounds capacity up, so it fills whole Alignment sized blocks
+	static size_type
+	padded(size_type capacity) noexcept
+	{
+		const auto bytes = capacity * sizeof(T);
+		const auto blocks = (bytes + Alignment - 1) / Alignment;
+		return (blocks * Alignment) / sizeof(T);
+	}
+
+	void
+	release() noexcept
+	{
+		util::destroy(_buffer, _buffer + _capacity);
+		_memory.reset();
+		_buffer = nullptr;
+		_capacity = 0;
+	}
+
+	std::unique_ptr<char[]> _memory;
+	T* _buffer = nullptr;
+	size_type _capacity = 0;
+};
+
+template<typename T, std::size_t Alignment>
+constexpr std::size_t AlignedStorage<T, Alignment>::alignment;
+
+} // namespace aisdi
+
+#endif
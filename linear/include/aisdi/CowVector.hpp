@@ -0,0 +1,445 @@
+#ifndef AISDI_COWVECTOR_HPP
+#define AISDI_COWVECTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "aisdi/algorithm.hpp"
+#include "aisdi/Vector.hpp"
+
+#include "gsl/gsl_assert"
+
+namespace aisdi {
+
+// Vector with copy-on-write semantics.
+//
+// Copies share one reference counted Vector, so taking a snapshot costs
+// O(1). First modification of a shared instance makes its private copy,
+// so only vectors, which are actually modified, pay for copying.
+// Reference count is atomic, so instances sharing a buffer may be used
+// from different threads; single instance still needs external
+// synchronization, like any other container. Checking whether a buffer
+// is no longer shared acquires the count, which is released by each
+// dropped copy, so reads made by other owners happen before the buffer
+// is modified in place.
+//
+// NOTE: Non-const accessors (begin(), data(), front(), ...) also make
+//  a private copy, since they allow modification. Prefer const ones
+//  (cbegin(), cend(), ...) for reading. Items must not be modified through
+//  iterators obtained before the vector was copied.
+template<typename T, typename Storage = HeapStorage<T>>
+class CowVector
+{
+public:
+	using vector_type = Vector<T, Storage>;
+	using value_type = typename vector_type::value_type;
+	using reference = typename vector_type::reference;
+	using const_reference = typename vector_type::const_reference;
+	using pointer = typename vector_type::pointer;
+	using const_pointer = typename vector_type::const_pointer;
+	using iterator = typename vector_type::iterator;
+	using const_iterator = typename vector_type::const_iterator;
+	using reverse_iterator = typename vector_type::reverse_iterator;
+	using const_reverse_iterator = typename vector_type::const_reverse_iterator;
+	using size_type = typename vector_type::size_type;
+	using difference_type = typename vector_type::difference_type;
+
+	CowVector() noexcept = default;
+
+	CowVector(std::initializer_list<T> ilist)
+		:	_buffer(new Buffer(ilist))
+	{}
+
+	explicit CowVector(vector_type vector)
+		:	_buffer(new Buffer(std::move(vector)))
+	{}
+
+	CowVector(const CowVector& other) noexcept
+		:	_buffer(other._buffer)
+	{
+		if(_buffer)
+		{
+			// New owner is made from an existing one, so nothing to order
+			_buffer->references.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	CowVector(CowVector&& other) noexcept
+		:	_buffer(other._buffer)
+	{
+		other._buffer = nullptr;
+	}
+
+	CowVector&
+	operator=(const CowVector& other) noexcept
+	{
+		auto copy = other;
+		std::swap(_buffer, copy._buffer);
+		return *this;
+	}
+
+	CowVector&
+	operator=(CowVector&& other) noexcept
+	{
+		auto moved = std::move(other);
+		std::swap(_buffer, moved._buffer);
+		return *this;
+	}
+
+	~CowVector()
+	{
+		release();
+	}
+
+	iterator
+	begin()
+	{
+		return detach().begin();
+	}
+
+	const_iterator
+	begin() const noexcept
+	{
+		return _buffer ? const_iterator{_buffer->vector.cbegin()} : const_iterator{};
+	}
+
+	iterator
+	end()
+	{
+		return detach().end();
+	}
+
+	const_iterator
+	end() const noexcept
+	{
+		return _buffer ? const_iterator{_buffer->vector.cend()} : const_iterator{};
+	}
+
+	const_iterator
+	cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	const_iterator
+	cend() const noexcept
+	{
+		return end();
+	}
+
+	reverse_iterator
+	rbegin()
+	{
+		return reverse_iterator{end()};
+	}
+
+	const_reverse_iterator
+	rbegin() const
+	{
+		return const_reverse_iterator{end()};
+	}
+
+	reverse_iterator
+	rend()
+	{
+		return reverse_iterator{begin()};
+	}
+
+	const_reverse_iterator
+	rend() const
+	{
+		return const_reverse_iterator{begin()};
+	}
+
+	const_reverse_iterator
+	crbegin() const
+	{
+		return rbegin();
+	}
+
+	const_reverse_iterator
+	crend() const
+	{
+		return rend();
+	}
+
+	pointer
+	data()
+	{
+		return detach().data();
+	}
+
+	const_pointer
+	data() const noexcept
+	{
+		return begin();
+	}
+
+	reference
+	front()
+	{
+		return detach().front();
+	}
+
+	const_reference
+	front() const
+	{
+		// Preconditions
+		Expects(_buffer);
+
+		return _buffer->vector.front();
+	}
+
+	reference
+	back()
+	{
+		return detach().back();
+	}
+
+	const_reference
+	back() const
+	{
+		// Preconditions
+		Expects(_buffer);
+
+		return _buffer->vector.back();
+	}
+
+	void
+	append(const T& item)
+	{
+		// Item may refer to shared buffer, which is about to be copied
+		const auto copy = item;
+		detach().append(copy);
+	}
+
+	void
+	prepend(const T& item)
+	{
+		const auto copy = item;
+		detach().prepend(copy);
+	}
+
+	iterator
+	insert(const_iterator pos, const T& value)
+	{
+		const auto index = indexOf(pos);
+		const auto copy = value;
+		auto& vector = detach();
+		return vector.insert(vector.cbegin() + index, copy);
+	}
+
+	T
+	popBack()
+	{
+		return detach().popBack();
+	}
+
+	T
+	popFront()
+	{
+		return detach().popFront();
+	}
+
+	void
+	clear()
+	{
+		if(!unique())
+		{
+			// Nothing to copy, just stop sharing
+			release();
+			return;
+		}
+
+		if(_buffer)
+		{
+			_buffer->vector.clear();
+		}
+	}
+
+	iterator
+	erase(const_iterator pos)
+	{
+		const auto index = indexOf(pos);
+		auto& vector = detach();
+		return vector.erase(vector.cbegin() + index);
+	}
+
+	iterator
+	erase(const_iterator first, const_iterator last)
+	{
+		const auto firstIndex = indexOf(first);
+		const auto lastIndex = indexOf(last);
+		auto& vector = detach();
+		return vector.erase(vector.cbegin() + firstIndex, vector.cbegin() + lastIndex);
+	}
+
+	iterator
+	erase_unordered(const_iterator pos)
+	{
+		const auto index = indexOf(pos);
+		auto& vector = detach();
+		return vector.erase_unordered(vector.cbegin() + index);
+	}
+
+	template<typename UnaryPredicate>
+	size_type
+	erase_if(UnaryPredicate pred)
+	{
+		if(std::none_of(cbegin(), cend(), pred))
+		{
+			return 0;
+		}
+
+		return detach().erase_if(pred);
+	}
+
+	size_type
+	remove_value_unordered(const T& value)
+	{
+		if(!aisdi::contains(cbegin(), cend(), value))
+		{
+			return 0;
+		}
+
+		const auto copy = value;
+		return detach().remove_value_unordered(copy);
+	}
+
+	void
+	resize(size_type count)
+	{
+		detach().resize(count);
+	}
+
+	void
+	reserve(size_type count)
+	{
+		detach().reserve(count);
+	}
+
+	void
+	shrink_to_fit()
+	{
+		detach().shrink_to_fit();
+	}
+
+	size_type
+	size() const noexcept
+	{
+		return _buffer ? _buffer->vector.size() : 0;
+	}
+
+	size_type
+	capacity() const noexcept
+	{
+		return _buffer ? _buffer->vector.capacity() : 0;
+	}
+
+	bool
+	empty() const noexcept
+	{
+		return (size() == 0);
+	}
+
+	// Checks whether this instance does not share its buffer with any other
+	bool
+	unique() const noexcept
+	{
+		return (!_buffer || _buffer->references.load(std::memory_order_acquire) == 1);
+	}
+
+	// Checks whether both instances share the same buffer
+	bool
+	shares(const CowVector& other) const noexcept
+	{
+		return (_buffer && _buffer == other._buffer);
+	}
+
+private:
+	struct Buffer
+	{
+		template<typename... Args>
+		explicit Buffer(Args&&... args)
+			:	vector(std::forward<Args>(args)...)
+		{}
+
+		std::atomic<long> references{1};
+		vector_type vector;
+	};
+
+	vector_type&
+	detach()
+	{
+		if(!_buffer)
+		{
+			_buffer = new Buffer();
+		}
+		else if(!unique())
+		{
+			const auto copy = new Buffer(_buffer->vector);
+			release();
+			_buffer = copy;
+		}
+
+		Ensures(unique());
+		return _buffer->vector;
+	}
+
+	// Drops this owner; the last one, which acquires all releases made by
+	// the others, destroys the buffer
+	void
+	release() noexcept
+	{
+		if(_buffer && _buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			delete _buffer;
+		}
+
+		_buffer = nullptr;
+	}
+
+	difference_type
+	indexOf(const_iterator pos) const
+	{
+		const auto index = std::distance(cbegin(), pos);
+
+		// Preconditions
+		Expects(index >= 0 && static_cast<size_type>(index) <= size());
+
+		return index;
+	}
+
+	Buffer* _buffer = nullptr;
+};
+
+template<typename T, typename Storage>
+inline bool
+operator==(const CowVector<T, Storage>& lhs, const CowVector<T, Storage>& rhs)
+{
+	if(lhs.shares(rhs))
+	{
+		return true;
+	}
+
+	if(lhs.size() != rhs.size())
+	{
+		return false;
+	}
+
+	return aisdi::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template<typename T, typename Storage>
+inline bool
+operator!=(const CowVector<T, Storage>& lhs, const CowVector<T, Storage>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+} // namespace aisdi
+
+#endif
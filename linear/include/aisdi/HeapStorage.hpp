@@ -0,0 +1,94 @@
+#ifndef AISDI_HEAPSTORAGE_HPP
+#define AISDI_HEAPSTORAGE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace aisdi {
+
+// Default storage policy of Vector: buffer of items allocated on the heap.
+//
+// Each storage policy owns a buffer of capacity() constructed items and
+// provides following interface:
+//  Storage() - empty storage, without any buffer
+//  explicit Storage(size_type capacity) - storage with given capacity
+//  Storage(Storage&&), operator=(Storage&&)
+//  data(), capacity()
+//  growInPlace(capacity) - tries to extend buffer without relocating items
+//  shrinkInPlace(capacity) - tries to give back memory past given capacity
+//      without relocating items
+// When any of in-place operations fails, Vector allocates new storage
+// and moves its items there.
+template<typename T>
+class HeapStorage
+{
+public:
+	using size_type = std::size_t;
+
+	HeapStorage() noexcept = default;
+
+	explicit HeapStorage(size_type capacity)
+		:	_buffer(std::make_unique<T[]>(capacity))
+		,	_capacity(capacity)
+	{}
+
+	HeapStorage(HeapStorage&& other) noexcept
+		:	_buffer(std::move(other._buffer))
+		,	_capacity(other._capacity)
+	{
+		other._capacity = 0;
+	}
+
+	HeapStorage&
+	operator=(HeapStorage&& other) noexcept
+	{
+		if(this != &other)
+		{
+			_buffer = std::move(other._buffer);
+			_capacity = other._capacity;
+
+			other._capacity = 0;
+		}
+
+		return *this;
+	}
+
+	T*
+	data() noexcept
+	{
+		return _buffer.get();
+	}
+
+	const T*
+	data() const noexcept
+	{
+		return _buffer.get();
+	}
+
+	size_type
+	capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	bool
+	growInPlace(size_type) noexcept
+	{
+		return false;
+	}
+
+	bool
+	shrinkInPlace(size_type) noexcept
+	{
+		return false;
+	}
+
+private:
+	std::unique_ptr<T[]> _buffer;
+	size_type _capacity = 0;
+};
+
+} // namespace aisdi
+
+#endif
@@ -6,13 +6,26 @@
 #include <iterator>
 #include <memory>
 
+#include "aisdi/instrumentation.hpp"
+
 #include "gsl/gsl_assert"
 
 namespace aisdi {
 
+namespace detail {
+
+struct ListProbeTag
+{
+	static const char* name() noexcept { return "List"; }
+};
+
+} // namespace detail
+
 template<typename T>
 class List
 {
+	using Probe = instrumentation::Probe<detail::ListProbeTag>;
+
 public:
 	using value_type = T;
 	using pointer = T*;
@@ -214,7 +227,7 @@ public:
 		auto prevNode = &_head;
 		std::for_each(first, last, [&prevNode](auto& value)
 			{
-				auto node = new Node{prevNode, nullptr, value};
+				auto node = createNode(prevNode, nullptr, value);
 				prevNode->next = node;
 				prevNode = node;
 			});
@@ -225,6 +238,7 @@ public:
 		const auto size = std::distance(first, last);
 		Expects(size >= 0);
 		_size = static_cast<size_type>(size);
+		Probe::sized(_size);
 	}
 
 	void
@@ -234,7 +248,7 @@ public:
 		while(node->next)
 		{
 			const auto next = node->next;
-			delete static_cast<Node*>(node);
+			destroyNode(node);
 			node = next;
 		}
 
@@ -266,10 +280,11 @@ public:
 		Expects(nextNode);
 
 		const auto prevNode = nextNode->prev;
-		auto newNode = new Node(prevNode, nextNode, value);
+		auto newNode = createNode(prevNode, nextNode, value);
 		prevNode->next = newNode;
 		nextNode->prev = newNode;
 		++_size;
+		Probe::sized(_size);
 
 		return iterator{newNode};
 	}
@@ -331,7 +346,7 @@ public:
 			auto nextNode = node->next;
 			Expects(nextNode);
 
-			delete static_cast<Node*>(node);
+			destroyNode(node);
 			node = nextNode;
 
 			_size--;
@@ -342,6 +357,35 @@ public:
 		return iterator{last};
 	}
 
+	// Moves item at it from other list (which may be this one) before pos.
+	// Item is relinked, so it is neither copied nor reallocated.
+	void
+	splice(const const_iterator& pos, List& other, const const_iterator& it)
+	{
+		auto nextNode = const_cast<BasicNode*>(pos._node);
+		auto node = const_cast<BasicNode*>(it._node);
+
+		// Preconditions
+		Expects(nextNode);
+		Expects(node && node->next); // node should not be the tail
+
+		if(node == nextNode || node->next == nextNode)
+		{
+			return;
+		}
+
+		node->prev->next = node->next;
+		node->next->prev = node->prev;
+		--other._size;
+
+		const auto prevNode = nextNode->prev;
+		node->prev = prevNode;
+		node->next = nextNode;
+		prevNode->next = node;
+		nextNode->prev = node;
+		++_size;
+	}
+
 	void remove(const T& value)
 	{
 		auto first = begin();
@@ -398,6 +442,23 @@ private:
 		T data;
 	};
 
+	template<typename U>
+	static Node*
+	createNode(BasicNode* prev, BasicNode* next, U&& value)
+	{
+		auto node = new Node(prev, next, std::forward<U>(value));
+		Probe::allocated(sizeof(Node));
+		Probe::copied(1);
+		return node;
+	}
+
+	static void
+	destroyNode(BasicNode* node) noexcept
+	{
+		delete static_cast<Node*>(node);
+		Probe::deallocated(sizeof(Node));
+	}
+
 	// NOTE: I've decided not to use RAII for managing Nodes lifetime
 	//  because of perfomance impact during List's destruction.
 	//  When using e.g. unique_ptr all items will be recursive deleted,
@@ -443,6 +504,9 @@ public:
 	using reference = typename List::const_reference;
 	using const_reference = typename List::const_reference;
 
+	// Singular iterator, which may be only assigned to
+	ConstIterator() noexcept = default;
+
 	explicit ConstIterator(const BasicNode* node)
 		:	_node(node)
 	{
@@ -550,7 +614,7 @@ public:
 	}
 
 private:
-	const BasicNode* _node;
+	const BasicNode* _node = nullptr;
 };
 
 template<typename T>
@@ -567,6 +631,8 @@ public:
 	using pointer = typename List::pointer;
 	using reference = typename List::reference;
 
+	Iterator() noexcept = default;
+
 	explicit Iterator(BasicNode* node)
 		:	ConstIterator(node)
 	{}
@@ -0,0 +1,552 @@
+#ifndef AISDI_MAPPEDVECTOR_HPP
+#define AISDI_MAPPEDVECTOR_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gsl/gsl_assert"
+
+namespace aisdi {
+
+// Vector of trivially copyable items kept in a memory mapped file.
+//
+// File starts with a small header (magic, format version, item size and
+// count) followed by packed items. Opening an existing file maps it
+// without any parsing, so items are available immediately and pages are
+// shared through page cache with other processes mapping the same file.
+//
+// In Shared mode changes are written back to the file, which is extended
+// as items are appended. In Private mode the file is opened read-only and
+// mapped copy-on-write: items may be modified, but changes are never
+// written back and the vector cannot grow beyond items stored in the file.
+//
+// NOTE: There should be at most one process appending to the file;
+//  readers should reopen it to see items appended after they mapped it.
+template<typename T>
+class MappedVector
+{
+	static_assert(std::is_trivially_copyable<T>::value,
+		"Only trivially copyable items may be stored in a file");
+
+	struct Header
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t itemSize;
+		std::uint64_t size;
+		std::uint64_t reserved[5];
+	};
+
+	static_assert(sizeof(Header) == 64, "Header should keep items cache line aligned");
+	static_assert(alignof(T) <= sizeof(Header), "Items would be misaligned");
+
+	constexpr static char Magic[8] = {'A', 'I', 'S', 'D', 'I', 'M', 'V', '\0'};
+	constexpr static auto ResizeMultiplier = 2;
+
+public:
+	enum class Mode
+	{
+		Shared,
+		Private
+	};
+
+	constexpr static std::uint32_t Version = 1;
+
+	using value_type = T;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	explicit MappedVector(const std::string& path, Mode mode = Mode::Shared)
+		:	_mode(mode)
+	{
+		const auto flags = (mode == Mode::Shared) ? (O_RDWR | O_CREAT) : O_RDONLY;
+		_fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+		if(_fd < 0)
+		{
+			throw std::system_error(errno, std::generic_category(),
+				"Could not open mapped vector " + path);
+		}
+
+		try
+		{
+			struct stat status;
+			if(::fstat(_fd, &status) != 0)
+			{
+				throw std::system_error(errno, std::generic_category(),
+					"Could not stat mapped vector " + path);
+			}
+
+			const auto fileSize = static_cast<size_type>(status.st_size);
+			if(fileSize == 0 && mode == Mode::Shared)
+			{
+				resizeFile(sizeof(Header));
+				map(sizeof(Header));
+				initHeader();
+			}
+			else
+			{
+				if(fileSize < sizeof(Header))
+				{
+					throw std::runtime_error("Could not open mapped vector: file is truncated");
+				}
+
+				map(fileSize);
+				checkHeader();
+			}
+		}
+		catch(...)
+		{
+			close();
+			throw;
+		}
+
+		// Postconditions
+		Ensures(size() <= capacity());
+	}
+
+	MappedVector(const MappedVector&) = delete;
+	MappedVector& operator=(const MappedVector&) = delete;
+
+	MappedVector(MappedVector&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	// Moved from vector has no mapping and is empty; it may only be
+	// queried, cleared, assigned or destroyed
+	MappedVector&
+	operator=(MappedVector&& other) noexcept
+	{
+		if(this != &other)
+		{
+			close();
+
+			_fd = other._fd;
+			_mapping = other._mapping;
+			_mappedBytes = other._mappedBytes;
+			_mode = other._mode;
+
+			other._fd = -1;
+			other._mapping = nullptr;
+			other._mappedBytes = 0;
+		}
+
+		return *this;
+	}
+
+	~MappedVector()
+	{
+		close();
+	}
+
+	iterator
+	begin() noexcept
+	{
+		return items();
+	}
+
+	const_iterator
+	begin() const noexcept
+	{
+		return items();
+	}
+
+	iterator
+	end() noexcept
+	{
+		return items() + size();
+	}
+
+	const_iterator
+	end() const noexcept
+	{
+		return items() + size();
+	}
+
+	const_iterator
+	cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	const_iterator
+	cend() const noexcept
+	{
+		return end();
+	}
+
+	reverse_iterator
+	rbegin()
+	{
+		return reverse_iterator{end()};
+	}
+
+	const_reverse_iterator
+	rbegin() const
+	{
+		return const_reverse_iterator{end()};
+	}
+
+	reverse_iterator
+	rend()
+	{
+		return reverse_iterator{begin()};
+	}
+
+	const_reverse_iterator
+	rend() const
+	{
+		return const_reverse_iterator{begin()};
+	}
+
+	pointer
+	data() noexcept
+	{
+		return items();
+	}
+
+	const_pointer
+	data() const noexcept
+	{
+		return items();
+	}
+
+	reference
+	operator[](size_type index)
+	{
+		// Preconditions
+		Expects(index < size());
+
+		return items()[index];
+	}
+
+	const_reference
+	operator[](size_type index) const
+	{
+		// Preconditions
+		Expects(index < size());
+
+		return items()[index];
+	}
+
+	reference
+	front()
+	{
+		// Preconditions
+		Expects(!empty());
+
+		return items()[0];
+	}
+
+	const_reference
+	front() const
+	{
+		return const_cast<MappedVector*>(this)->front();
+	}
+
+	reference
+	back()
+	{
+		// Preconditions
+		Expects(!empty());
+
+		return items()[size() - 1];
+	}
+
+	const_reference
+	back() const
+	{
+		return const_cast<MappedVector*>(this)->back();
+	}
+
+	void
+	append(const T& item)
+	{
+		const auto newSize = size() + 1;
+		if(newSize > capacity())
+		{
+			// Item may refer to mapping, which is about to be replaced
+			const auto copy = item;
+			reserve(newSize * ResizeMultiplier);
+			items()[size()] = copy;
+		}
+		else
+		{
+			items()[size()] = item;
+		}
+
+		header()->size = newSize;
+	}
+
+	T
+	popBack()
+	{
+		// Preconditions
+		Expects(!empty());
+
+		const auto result = back();
+		--header()->size;
+		return result;
+	}
+
+	void
+	clear() noexcept
+	{
+		if(_mapping)
+		{
+			header()->size = 0;
+		}
+	}
+
+	void
+	resize(size_type count)
+	{
+		if(count > capacity())
+		{
+			reserve(count);
+		}
+
+		if(count > size())
+		{
+			std::fill(end(), begin() + count, T{});
+		}
+
+		header()->size = count;
+	}
+
+	// Extends the file, so it may hold at least count items
+	void
+	reserve(size_type count)
+	{
+		// Preconditions
+		Expects(_mode == Mode::Shared);
+
+		if(count <= capacity())
+		{
+			return;
+		}
+
+		const auto bytes = sizeof(Header) + (count * sizeof(T));
+		resizeFile(bytes);
+		try
+		{
+			remap(bytes);
+		}
+		catch(...)
+		{
+			// File is truncated back, so a failed grow leaves no trace
+			static_cast<void>(::ftruncate(_fd, static_cast<off_t>(_mappedBytes)));
+			throw;
+		}
+
+		// Postconditions
+		Ensures(capacity() >= count);
+	}
+
+	// Truncates the file right after the last item
+	void
+	shrink_to_fit()
+	{
+		// Preconditions
+		Expects(_mode == Mode::Shared);
+
+		const auto bytes = sizeof(Header) + (size() * sizeof(T));
+		if(bytes < _mappedBytes)
+		{
+			remap(bytes);
+			resizeFile(bytes);
+		}
+	}
+
+	// Flushes changes to the file
+	void
+	sync()
+	{
+		if(_mode == Mode::Shared && _mapping && ::msync(_mapping, _mappedBytes, MS_SYNC) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(),
+				"Could not sync mapped vector");
+		}
+	}
+
+	size_type
+	size() const noexcept
+	{
+		return _mapping ? static_cast<size_type>(header()->size) : 0;
+	}
+
+	size_type
+	capacity() const noexcept
+	{
+		return _mapping ? (_mappedBytes - sizeof(Header)) / sizeof(T) : 0;
+	}
+
+	bool
+	empty() const noexcept
+	{
+		return (size() == 0);
+	}
+
+	Mode
+	mode() const noexcept
+	{
+		return _mode;
+	}
+
+private:
+	Header*
+	header() noexcept
+	{
+		return static_cast<Header*>(_mapping);
+	}
+
+	const Header*
+	header() const noexcept
+	{
+		return static_cast<const Header*>(_mapping);
+	}
+
+	T*
+	items() noexcept
+	{
+		return _mapping ? reinterpret_cast<T*>(static_cast<char*>(_mapping) + sizeof(Header)) : nullptr;
+	}
+
+	const T*
+	items() const noexcept
+	{
+		return const_cast<MappedVector*>(this)->items();
+	}
+
+	void
+	initHeader() noexcept
+	{
+		auto& h = *header();
+		std::memcpy(h.magic, Magic, sizeof(Magic));
+		h.version = Version;
+		h.itemSize = sizeof(T);
+		h.size = 0;
+		std::fill(std::begin(h.reserved), std::end(h.reserved), 0);
+	}
+
+	void
+	checkHeader() const
+	{
+		const auto& h = *header();
+		if(std::memcmp(h.magic, Magic, sizeof(Magic)) != 0)
+		{
+			throw std::runtime_error("Could not open mapped vector: invalid magic");
+		}
+
+		if(h.version != Version)
+		{
+			throw std::runtime_error("Could not open mapped vector: unsupported version");
+		}
+
+		if(h.itemSize != sizeof(T))
+		{
+			throw std::runtime_error("Could not open mapped vector: invalid item size");
+		}
+
+		if(h.size > capacity())
+		{
+			throw std::runtime_error("Could not open mapped vector: file is truncated");
+		}
+	}
+
+	void
+	resizeFile(size_type bytes)
+	{
+		if(::ftruncate(_fd, static_cast<off_t>(bytes)) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(),
+				"Could not resize mapped vector");
+		}
+	}
+
+	void*
+	mapFile(size_type bytes) const
+	{
+		const auto flags = (_mode == Mode::Shared) ? MAP_SHARED : MAP_PRIVATE;
+		const auto mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, _fd, 0);
+		if(mapping == MAP_FAILED)
+		{
+			throw std::system_error(errno, std::generic_category(),
+				"Could not map mapped vector");
+		}
+
+		return mapping;
+	}
+
+	void
+	map(size_type bytes)
+	{
+		_mapping = mapFile(bytes);
+		_mappedBytes = bytes;
+	}
+
+	// The new mapping is made before the old one is released,
+	// so a failure leaves the vector mapped as it was
+	void
+	remap(size_type bytes)
+	{
+		const auto mapping = mapFile(bytes);
+		::munmap(_mapping, _mappedBytes);
+		_mapping = mapping;
+		_mappedBytes = bytes;
+	}
+
+	void
+	close() noexcept
+	{
+		if(_mapping)
+		{
+			::munmap(_mapping, _mappedBytes);
+		}
+
+		if(_fd >= 0)
+		{
+			::close(_fd);
+		}
+
+		_fd = -1;
+		_mapping = nullptr;
+		_mappedBytes = 0;
+	}
+
+	int _fd = -1;
+	void* _mapping = nullptr;
+	size_type _mappedBytes = 0;
+	Mode _mode = Mode::Shared;
+};
+
+template<typename T>
+constexpr char MappedVector<T>::Magic[8];
+
+template<typename T>
+constexpr std::uint32_t MappedVector<T>::Version;
+
+} // namespace aisdi
+
+#endif
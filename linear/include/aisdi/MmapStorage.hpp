@@ -0,0 +1,230 @@
+#ifndef AISDI_MMAPSTORAGE_HPP
+#define AISDI_MMAPSTORAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "gsl/gsl_assert"
+
+namespace aisdi {
+
+// Storage policy of Vector backed by anonymous memory mapping, meant for
+// very large arrays of trivial items, e.g. aisdi::Vector<int, MmapStorage<int>>.
+//
+// Range of ReservedBytes of address space is reserved up front, without
+// any memory behind it. Vector growth commits further pages of that range
+// in place, so items are never copied until the reservation is exhausted.
+// Shrinking decommits pages and returns them with MADV_DONTNEED.
+// When HugePages is set, the range is aligned to and committed in whole
+// huge pages and is advised with MADV_HUGEPAGE.
+template<typename T,
+         std::size_t ReservedBytes = (std::size_t{1} << 36),
+         bool HugePages = true>
+class MmapStorage
+{
+	static_assert(std::is_trivial<T>::value,
+		"Mapped pages are zero-filled, so only trivial items may be stored");
+
+	constexpr static std::size_t HugePageSize = (std::size_t{1} << 21);
+
+public:
+	using size_type = std::size_t;
+
+	MmapStorage() noexcept = default;
+
+	explicit MmapStorage(size_type capacity)
+	{
+		if(capacity == 0)
+		{
+			return;
+		}
+
+		reserve(std::max(ReservedBytes, capacity * sizeof(T)));
+		if(!growInPlace(capacity))
+		{
+			release();
+			throw std::bad_alloc();
+		}
+
+		// Postconditions
+		Ensures(_capacity >= capacity);
+	}
+
+	MmapStorage(MmapStorage&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MmapStorage&
+	operator=(MmapStorage&& other) noexcept
+	{
+		if(this != &other)
+		{
+			release();
+
+			_base = other._base;
+			_reserved = other._reserved;
+			_committed = other._committed;
+			_capacity = other._capacity;
+
+			other._base = nullptr;
+			other._reserved = other._committed = other._capacity = 0;
+		}
+
+		return *this;
+	}
+
+	~MmapStorage()
+	{
+		release();
+	}
+
+	T*
+	data() noexcept
+	{
+		return static_cast<T*>(_base);
+	}
+
+	const T*
+	data() const noexcept
+	{
+		return static_cast<const T*>(_base);
+	}
+
+	size_type
+	capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	bool
+	growInPlace(size_type capacity)
+	{
+		const auto bytes = roundUp(capacity * sizeof(T));
+		if(!_base || bytes > _reserved)
+		{
+			return false;
+		}
+
+		if(bytes > _committed)
+		{
+			const auto first = static_cast<char*>(_base) + _committed;
+			if(mprotect(first, bytes - _committed, PROT_READ | PROT_WRITE) != 0)
+			{
+				throw std::bad_alloc();
+			}
+
+			_committed = bytes;
+			_capacity = _committed / sizeof(T);
+		}
+
+		return true;
+	}
+
+	bool
+	shrinkInPlace(size_type capacity) noexcept
+	{
+		if(!_base)
+		{
+			return false;
+		}
+
+		const auto bytes = roundUp(capacity * sizeof(T));
+		if(bytes < _committed)
+		{
+			const auto first = static_cast<char*>(_base) + bytes;
+			madvise(first, _committed - bytes, MADV_DONTNEED);
+			mprotect(first, _committed - bytes, PROT_NONE);
+
+			_committed = bytes;
+			_capacity = _committed / sizeof(T);
+		}
+
+		return true;
+	}
+
+private:
+	static size_type
+	granularity() noexcept
+	{
+		static const auto pageSize = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+		return HugePages ? std::max(pageSize, HugePageSize) : pageSize;
+	}
+
+	static size_type
+	roundUp(size_type bytes) noexcept
+	{
+		const auto unit = granularity();
+		return ((bytes + unit - 1) / unit) * unit;
+	}
+
+	void
+	reserve(size_type bytes)
+	{
+		// Oversized by one unit, so base may be aligned to huge page
+		const auto unit = granularity();
+		const auto reserved = roundUp(bytes);
+		const auto mappedSize = reserved + unit;
+		const auto mapped = mmap(nullptr, mappedSize, PROT_NONE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if(mapped == MAP_FAILED)
+		{
+			throw std::bad_alloc();
+		}
+
+		const auto address = reinterpret_cast<std::uintptr_t>(mapped);
+		const auto aligned = ((address + unit - 1) / unit) * unit;
+		const auto head = aligned - address;
+		if(head > 0)
+		{
+			munmap(mapped, head);
+		}
+
+		const auto tail = mappedSize - head - reserved;
+		if(tail > 0)
+		{
+			munmap(reinterpret_cast<char*>(aligned) + reserved, tail);
+		}
+
+		_base = reinterpret_cast<void*>(aligned);
+		_reserved = reserved;
+		_committed = 0;
+		_capacity = 0;
+
+#ifdef MADV_HUGEPAGE
+		if(HugePages)
+		{
+			// NOTE: Only a hint, kernel may run without transparent huge pages
+			madvise(_base, _reserved, MADV_HUGEPAGE);
+		}
+#endif
+	}
+
+	void
+	release() noexcept
+	{
+		if(_base)
+		{
+			munmap(_base, _reserved);
+		}
+
+		_base = nullptr;
+		_reserved = _committed = _capacity = 0;
+	}
+
+	void* _base = nullptr;
+	size_type _reserved = 0;
+	size_type _committed = 0;
+	size_type _capacity = 0;
+};
+
+} // namespace aisdi
+
+#endif
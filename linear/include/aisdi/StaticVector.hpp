@@ -0,0 +1,524 @@
+#ifndef AISDI_STATICVECTOR_HPP
+#define AISDI_STATICVECTOR_HPP
+
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "aisdi/util.hpp"
+
+#include "gsl/gsl_assert"
+
+namespace aisdi {
+namespace detail {
+
+// NOTE: Trivial types are kept in a plain array, so the whole container
+//  stays a literal type and may be used in constant expressions.
+//  Other types are kept in raw storage and constructed in place.
+template<typename T, std::size_t N, bool = std::is_trivial<T>::value>
+class StaticVectorStorage
+{
+protected:
+	constexpr StaticVectorStorage() noexcept
+		:	_buffer{}
+	{}
+
+	constexpr T*
+	items() noexcept
+	{
+		return _buffer;
+	}
+
+	constexpr const T*
+	items() const noexcept
+	{
+		return _buffer;
+	}
+
+	template<typename U>
+	constexpr void
+	construct(std::size_t index, U&& value)
+	{
+		_buffer[index] = std::forward<U>(value);
+	}
+
+	constexpr void
+	destroy(std::size_t) noexcept
+	{}
+
+	T _buffer[(N > 0) ? N : 1];
+	std::size_t _size = 0;
+};
+
+template<typename T, std::size_t N>
+class StaticVectorStorage<T, N, false>
+{
+protected:
+	StaticVectorStorage() noexcept = default;
+
+	StaticVectorStorage(const StaticVectorStorage&) = delete;
+	StaticVectorStorage& operator=(const StaticVectorStorage&) = delete;
+
+	~StaticVectorStorage()
+	{
+		util::destroy(items(), items() + _size);
+	}
+
+	T*
+	items() noexcept
+	{
+		return reinterpret_cast<T*>(_buffer);
+	}
+
+	const T*
+	items() const noexcept
+	{
+		return reinterpret_cast<const T*>(_buffer);
+	}
+
+	template<typename U>
+	void
+	construct(std::size_t index, U&& value)
+	{
+		new (items() + index) T(std::forward<U>(value));
+	}
+
+	void
+	destroy(std::size_t index) noexcept
+	{
+		util::destroy_at(items() + index);
+	}
+
+	std::aligned_storage_t<sizeof(T), alignof(T)> _buffer[(N > 0) ? N : 1];
+	std::size_t _size = 0;
+};
+
+} // namespace detail
+
+template<typename T, std::size_t N>
+class StaticVector
+	:	private detail::StaticVectorStorage<T, N>
+{
+	using Storage = detail::StaticVectorStorage<T, N>;
+	using Storage::_size;
+	using Storage::items;
+	using Storage::construct;
+	using Storage::destroy;
+
+public:
+	using value_type = T;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	StaticVector() noexcept = default;
+
+	constexpr StaticVector(std::initializer_list<T> ilist)
+		:	Storage()
+	{
+		// Preconditions
+		Expects(ilist.size() <= N);
+
+		for(const auto& item : ilist)
+		{
+			construct(_size, item);
+			++_size;
+		}
+
+		// Postconditions
+		Ensures(_size == ilist.size());
+	}
+
+	constexpr StaticVector(const StaticVector& other)
+		:	Storage()
+	{
+		for(const auto& item : other)
+		{
+			construct(_size, item);
+			++_size;
+		}
+
+		// Postconditions
+		Ensures(_size == other._size);
+	}
+
+	constexpr StaticVector(StaticVector&& other)
+		noexcept(std::is_nothrow_move_constructible<T>::value)
+		:	Storage()
+	{
+		for(auto& item : other)
+		{
+			construct(_size, std::move(item));
+			++_size;
+		}
+
+		other.clear();
+	}
+
+	~StaticVector() = default;
+
+	constexpr StaticVector&
+	operator=(const StaticVector& other)
+	{
+		if(this != &other)
+		{
+			// NOTE: Basic exception safety
+			clear();
+			for(const auto& item : other)
+			{
+				construct(_size, item);
+				++_size;
+			}
+		}
+
+		return *this;
+	}
+
+	constexpr StaticVector&
+	operator=(StaticVector&& other)
+		noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		if(this != &other)
+		{
+			clear();
+			for(auto& item : other)
+			{
+				construct(_size, std::move(item));
+				++_size;
+			}
+
+			other.clear();
+		}
+
+		return *this;
+	}
+
+	constexpr iterator
+	begin() noexcept
+	{
+		return items();
+	}
+
+	constexpr const_iterator
+	begin() const noexcept
+	{
+		return items();
+	}
+
+	constexpr iterator
+	end() noexcept
+	{
+		return items() + _size;
+	}
+
+	constexpr const_iterator
+	end() const noexcept
+	{
+		return items() + _size;
+	}
+
+	constexpr const_iterator
+	cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	constexpr const_iterator
+	cend() const noexcept
+	{
+		return end();
+	}
+
+	reverse_iterator
+	rbegin()
+	{
+		return reverse_iterator{end()};
+	}
+
+	const_reverse_iterator
+	rbegin() const
+	{
+		return const_reverse_iterator{end()};
+	}
+
+	reverse_iterator
+	rend()
+	{
+		return reverse_iterator{begin()};
+	}
+
+	const_reverse_iterator
+	rend() const
+	{
+		return const_reverse_iterator{begin()};
+	}
+
+	const_reverse_iterator
+	crbegin() const
+	{
+		return rbegin();
+	}
+
+	const_reverse_iterator
+	crend() const
+	{
+		return rend();
+	}
+
+	constexpr pointer
+	data() noexcept
+	{
+		return items();
+	}
+
+	constexpr const_pointer
+	data() const noexcept
+	{
+		return items();
+	}
+
+	constexpr reference
+	operator[](size_type index)
+	{
+		// Preconditions
+		Expects(index < _size);
+
+		return items()[index];
+	}
+
+	constexpr const_reference
+	operator[](size_type index) const
+	{
+		// Preconditions
+		Expects(index < _size);
+
+		return items()[index];
+	}
+
+	constexpr reference
+	front()
+	{
+		// Preconditions
+		Expects(_size > 0);
+
+		return items()[0];
+	}
+
+	constexpr const_reference
+	front() const
+	{
+		// Preconditions
+		Expects(_size > 0);
+
+		return items()[0];
+	}
+
+	constexpr reference
+	back()
+	{
+		// Preconditions
+		Expects(_size > 0);
+
+		return items()[_size - 1];
+	}
+
+	constexpr const_reference
+	back() const
+	{
+		// Preconditions
+		Expects(_size > 0);
+
+		return items()[_size - 1];
+	}
+
+	constexpr void
+	append(const T& item)
+	{
+		insert(end(), item);
+	}
+
+	constexpr void
+	prepend(const T& item)
+	{
+		insert(begin(), item);
+	}
+
+	constexpr iterator
+	insert(const_iterator pos, const T& value)
+	{
+		// Preconditions
+		Expects(_size < N);
+		Expects(pos >= begin() && pos <= end());
+
+		// NOTE: Basic exception safety
+
+		const auto index = static_cast<size_type>(pos - begin());
+		if(index == _size)
+		{
+			construct(_size, value);
+			++_size;
+			return begin() + index;
+		}
+
+		// Value may refer to one of the shifted items
+		T copy = value;
+		construct(_size, std::move(items()[_size - 1]));
+		for(auto i = _size - 1; i > index; --i)
+		{
+			items()[i] = std::move(items()[i - 1]);
+		}
+
+		items()[index] = std::move(copy);
+		++_size;
+		return begin() + index;
+	}
+
+	constexpr T
+	popBack()
+	{
+		// Preconditions
+		Expects(_size > 0);
+
+		T result = std::move(back());
+		destroy(--_size);
+		return result;
+	}
+
+	constexpr T
+	popFront()
+	{
+		// NOTE: Basic exception safety
+		// Preconditions
+		Expects(_size > 0);
+
+		T result = std::move(front());
+		erase(begin());
+		return result;
+	}
+
+	constexpr void
+	clear() noexcept
+	{
+		while(_size > 0)
+		{
+			destroy(--_size);
+		}
+	}
+
+	constexpr iterator
+	erase(const_iterator pos)
+	{
+		return erase(pos, pos + 1);
+	}
+
+	constexpr iterator
+	erase(const_iterator first, const_iterator last)
+	{
+		// Preconditions
+		Expects(first >= begin() && first <= last && last <= end());
+
+		const auto firstIndex = static_cast<size_type>(first - begin());
+		const auto lastIndex = static_cast<size_type>(last - begin());
+		if(firstIndex == lastIndex)
+		{
+			return begin() + firstIndex;
+		}
+
+		// NOTE: Basic exception safety
+
+		auto to = firstIndex;
+		for(auto from = lastIndex; from < _size; ++from, ++to)
+		{
+			items()[to] = std::move(items()[from]);
+		}
+
+		while(_size > to)
+		{
+			destroy(--_size);
+		}
+
+		return begin() + firstIndex;
+	}
+
+	constexpr void
+	resize(size_type count)
+	{
+		// Preconditions
+		Expects(count <= N);
+
+		while(_size > count)
+		{
+			destroy(--_size);
+		}
+
+		while(_size < count)
+		{
+			construct(_size, T{});
+			++_size;
+		}
+	}
+
+	constexpr size_type
+	size() const noexcept
+	{
+		return _size;
+	}
+
+	constexpr static size_type
+	capacity() noexcept
+	{
+		return N;
+	}
+
+	constexpr bool
+	empty() const noexcept
+	{
+		return (_size == 0);
+	}
+
+	constexpr bool
+	full() const noexcept
+	{
+		return (_size == N);
+	}
+};
+
+template<typename T, std::size_t N>
+constexpr bool
+operator==(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs)
+{
+	if(lhs.size() != rhs.size())
+	{
+		return false;
+	}
+
+	for(auto i = std::size_t{0}; i < lhs.size(); ++i)
+	{
+		if(!(lhs.data()[i] == rhs.data()[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename T, std::size_t N>
+constexpr bool
+operator!=(const StaticVector<T, N>& lhs, const StaticVector<T, N>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+} // namespace aisdi
+
+#endif
@@ -6,17 +6,31 @@
 #include <iterator>
 #include <memory>
 
+#include "aisdi/algorithm.hpp"
+#include "aisdi/HeapStorage.hpp"
+#include "aisdi/instrumentation.hpp"
 #include "aisdi/util.hpp"
 
 #include "gsl/gsl_assert"
 
 namespace aisdi {
 
-template<typename T>
+namespace detail {
+
+struct VectorProbeTag
+{
+	static const char* name() noexcept { return "Vector"; }
+};
+
+} // namespace detail
+
+template<typename T, typename Storage = HeapStorage<T>>
 class Vector
 {
 	constexpr static auto ResizeMultiplier = 2;
 
+	using Probe = instrumentation::Probe<detail::VectorProbeTag>;
+
 public:
 	using value_type = T;
 	using reference = T&;
@@ -33,39 +47,42 @@ public:
 	Vector() noexcept = default;
 
 	Vector(std::initializer_list<T> ilist)
-		:	_buffer(std::make_unique<T[]>(ilist.size()))
+		:	_storage(allocate(ilist.size()))
 		,	_size(ilist.size())
-		,	_capacity(ilist.size())
 	{
 		std::copy(ilist.begin(), ilist.end(), begin());
+		Probe::copied(_size);
+		Probe::sized(_size);
 
 		// Postconditions
 		Ensures(_size == ilist.size());
-		Ensures(_capacity == _size);
+		Ensures(capacity() >= _size);
 	}
 
 	Vector(const Vector& other)
-		:	_buffer(std::make_unique<T[]>(other._capacity))
+		:	_storage(allocate(other.capacity()))
 		,	_size(other._size)
-		,	_capacity(other._capacity)
 	{
 		std::copy(other.begin(), other.end(), begin());
+		Probe::copied(_size);
+		Probe::sized(_size);
 
 		// Postconditions
 		Ensures(_size == other.size());
-		Ensures(_capacity == other._capacity);
+		Ensures(capacity() >= other.capacity());
 	}
 
 	Vector(Vector&& other) noexcept
-		:	_buffer(std::move(other._buffer))
+		:	_storage(std::move(other._storage))
 		,	_size(other._size)
-		,	_capacity(other._capacity)
 	{
 		other._size = 0;
-		other._capacity = 0;
 	}
 
-	~Vector() = default;
+	~Vector()
+	{
+		onRelease();
+	}
 
 	Vector&
 	operator=(const Vector& other)
@@ -74,12 +91,13 @@ public:
 		{
 			// NOTE: Strong exception safety
 
-			auto newBuffer = std::make_unique<T[]>(other._capacity);
-			std::copy(other.begin(), other.end(), newBuffer.get());
+			auto newStorage = allocate(other.capacity());
+			std::copy(other.begin(), other.end(), newStorage.data());
+			Probe::copied(other._size);
 
-			_buffer = std::move(newBuffer);
+			onRelease();
+			_storage = std::move(newStorage);
 			_size = other._size;
-			_capacity = other._capacity;
 		}
 
 		return *this;
@@ -90,11 +108,11 @@ public:
 	{
 		if(this != &other)
 		{
-			_buffer = std::move(other._buffer);
+			onRelease();
+			_storage = std::move(other._storage);
 			_size = other._size;
-			_capacity = other._capacity;
 
-			other._size = other._capacity = 0;
+			other._size = 0;
 		}
 
 		return *this;
@@ -103,25 +121,25 @@ public:
 	iterator
 	begin()
 	{
-		return {_buffer.get()};
+		return {_storage.data()};
 	}
 
 	const_iterator
 	begin() const
 	{
-		return {_buffer.get()};
+		return {_storage.data()};
 	}
 
 	iterator
 	end()
 	{
-		return {_buffer.get() + _size};
+		return {_storage.data() + _size};
 	}
 
 	const_iterator
 	end() const
 	{
-		return {_buffer.get() + _size};
+		return {_storage.data() + _size};
 	}
 
 	const_iterator
@@ -175,13 +193,13 @@ public:
 	pointer
 	data() noexcept
 	{
-		return _buffer.get();
+		return _storage.data();
 	}
 
 	const_pointer
 	data() const noexcept
 	{
-		return _buffer.get();
+		return _storage.data();
 	}
 
 	reference
@@ -189,9 +207,9 @@ public:
 	{
 		// Preconditions
 		Expects(_size > 0);
-		Expects(_buffer);
+		Expects(data());
 
-		return _buffer[0];
+		return data()[0];
 	}
 
 	const_reference
@@ -205,9 +223,9 @@ public:
 	{
 		// Preconditions
 		Expects(_size > 0);
-		Expects(_buffer);
+		Expects(data());
 
-		return _buffer[_size - 1];
+		return data()[_size - 1];
 	}
 
 	const_reference
@@ -286,6 +304,59 @@ public:
 			const_cast<iterator>(last));
 	}
 
+	// Erases item at pos by moving the last item in its place.
+	// Constant time, but order of the items is not preserved.
+	iterator
+	erase_unordered(const_iterator pos)
+	{
+		// Preconditions
+		Expects(std::distance(cbegin(), pos) >= 0
+			&& std::distance(pos, cend()) > 0);
+
+		const auto first = const_cast<iterator>(pos);
+		const auto last = std::prev(end());
+		if(first != last)
+		{
+			*first = std::move(*last);
+			Probe::moved(1);
+		}
+
+		eraseImpl(last, end());
+		return first;
+	}
+
+	// Erases all items satisfying pred in a single compaction pass,
+	// preserving order of the remaining ones. Returns number of erased items.
+	template<typename UnaryPredicate>
+	size_type
+	erase_if(UnaryPredicate pred)
+	{
+		const auto first = std::remove_if(begin(), end(), pred);
+		const auto count = static_cast<size_type>(std::distance(first, end()));
+		eraseImpl(first, end());
+		return count;
+	}
+
+	// Erases all items equal to value with erase_unordered.
+	// Returns number of erased items.
+	size_type
+	remove_value_unordered(const T& value)
+	{
+		// Value may refer to one of the moved items
+		const auto item = value;
+
+		auto count = size_type{0};
+		auto pos = aisdi::find(begin(), end(), item);
+		while(pos != end())
+		{
+			pos = erase_unordered(pos);
+			pos = aisdi::find(pos, end(), item);
+			++count;
+		}
+
+		return count;
+	}
+
 	void resize(size_type count)
 	{
 		if(count < _size)
@@ -296,15 +367,13 @@ public:
 			return;
 		}
 
-		if(count > _capacity)
+		if(count > capacity())
 		{
-			auto newBuffer = std::make_unique<T[]>(count);
-			std::move(begin(), end(), newBuffer.get());
-			_buffer = std::move(newBuffer);
-			_capacity = count;
+			reallocate(count);
 		}
 
 		_size = count;
+		Probe::sized(_size);
 		const auto last = end();
 		const auto first = std::prev(last, static_cast<difference_type>(count));
 		std::for_each(first, last,
@@ -314,12 +383,36 @@ public:
 			});
 	}
 
+	void
+	reserve(size_type count)
+	{
+		if(count > capacity())
+		{
+			reallocate(count);
+		}
+	}
+
+	void
+	shrink_to_fit()
+	{
+		if(_size < capacity())
+		{
+			reallocate(_size);
+		}
+	}
+
 	size_type
 	size() const noexcept
 	{
 		return _size;
 	}
 
+	size_type
+	capacity() const noexcept
+	{
+		return _storage.capacity();
+	}
+
 	bool
 	empty() const noexcept
 	{
@@ -337,28 +430,38 @@ private:
 		// NOTE: Basic exception safety
 
 		const auto newSize = (_size + 1);
-		if(newSize > _capacity)
+		if(newSize > capacity())
 		{
 			const auto newCapacity = (newSize * ResizeMultiplier);
-			auto newBuffer = std::make_unique<T[]>(newCapacity);
-
-			const auto newPos = std::move(begin(), pos, newBuffer.get());
-			*newPos = value;
-			std::move(pos, end(), newPos + 1);
-
-			_buffer = std::move(newBuffer);
-			_capacity = newCapacity;
-			_size = newSize;
-			return newPos;
+			if(!growInPlace(newCapacity))
+			{
+				auto newStorage = allocate(newCapacity);
+
+				const auto newPos = std::move(begin(), pos, newStorage.data());
+				*newPos = value;
+				std::move(pos, end(), newPos + 1);
+				Probe::reallocated();
+				Probe::moved(_size);
+				Probe::copied(1);
+
+				onRelease();
+				_storage = std::move(newStorage);
+				_size = newSize;
+				Probe::sized(_size);
+				return newPos;
+			}
 		}
 
 		// Preconditions
-		Expects(_buffer);
+		Expects(data());
 
 		std::move_backward(pos, end(), end() + 1);
 		*pos = value;
+		Probe::moved(static_cast<size_type>(std::distance(pos, end())));
+		Probe::copied(1);
 
 		_size = newSize;
+		Probe::sized(_size);
 		return pos;
 	}
 
@@ -379,6 +482,7 @@ private:
 		Expects(std::distance(first, last) >= 0);
 
 		const auto afterLastMoved = std::move(last, end(), first);
+		Probe::moved(static_cast<size_type>(std::distance(last, end())));
 		util::destroy(afterLastMoved, end());
 
 		const auto count = std::distance(first, last);
@@ -388,26 +492,98 @@ private:
 		return first;
 	}
 
-	std::unique_ptr<T[]> _buffer;
+	void
+	reallocate(size_type newCapacity)
+	{
+		// NOTE: Strong exception safety
+
+		if(newCapacity > capacity() && growInPlace(newCapacity))
+		{
+			return;
+		}
+
+		if(newCapacity < capacity() && shrinkInPlace(newCapacity))
+		{
+			return;
+		}
+
+		auto newStorage = allocate(newCapacity);
+		std::move(begin(), end(), newStorage.data());
+		Probe::reallocated();
+		Probe::moved(_size);
+
+		onRelease();
+		_storage = std::move(newStorage);
+	}
+
+	// Wrappers of storage operations reporting them to instrumentation
+
+	static Storage
+	allocate(size_type capacity)
+	{
+		auto storage = Storage(capacity);
+		if(storage.data())
+		{
+			Probe::allocated(storage.capacity() * sizeof(T));
+		}
+
+		return storage;
+	}
+
+	void
+	onRelease() noexcept
+	{
+		if(_storage.data())
+		{
+			Probe::deallocated(capacity() * sizeof(T));
+		}
+	}
+
+	bool
+	growInPlace(size_type newCapacity)
+	{
+		const auto oldCapacity = capacity();
+		if(!_storage.growInPlace(newCapacity))
+		{
+			return false;
+		}
+
+		Probe::resizedInPlace(oldCapacity * sizeof(T), capacity() * sizeof(T));
+		return true;
+	}
+
+	bool
+	shrinkInPlace(size_type newCapacity) noexcept
+	{
+		const auto oldCapacity = capacity();
+		if(!_storage.shrinkInPlace(newCapacity))
+		{
+			return false;
+		}
+
+		Probe::resizedInPlace(oldCapacity * sizeof(T), capacity() * sizeof(T));
+		return true;
+	}
+
+	Storage _storage;
 	size_type _size = 0;
-	size_type _capacity = 0;
 };
 
-template<typename T>
+template<typename T, typename Storage>
 inline bool
-operator==(const Vector<T>& lhs, const Vector<T>& rhs)
+operator==(const Vector<T, Storage>& lhs, const Vector<T, Storage>& rhs)
 {
 	if(lhs.size() != rhs.size())
 	{
 		return false;
 	}
 
-	return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+	return aisdi::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
 }
 
-template<typename T>
+template<typename T, typename Storage>
 inline bool
-operator!=(const Vector<T>& lhs, const Vector<T>& rhs)
+operator!=(const Vector<T, Storage>& lhs, const Vector<T, Storage>& rhs)
 {
 	return !(lhs == rhs);
 }
@@ -0,0 +1,143 @@
+#ifndef AISDI_ALGORITHM_HPP
+#define AISDI_ALGORITHM_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "aisdi/simd.hpp"
+
+namespace aisdi {
+namespace detail {
+
+// Contiguous range of arithmetic items (e.g. Vector<int>::iterator),
+// which may be processed with aisdi::simd kernels.
+template<typename It, typename T>
+struct IsVectorizableRange
+	:	std::integral_constant<bool,
+			std::is_pointer<It>::value
+			&& std::is_same<std::remove_cv_t<std::remove_pointer_t<It>>,
+			                std::remove_cv_t<T>>::value
+			&& simd::IsVectorizable<std::remove_cv_t<T>>::value>
+{};
+
+template<typename It, typename T>
+It
+find(It first, It last, const T& value, std::false_type)
+{
+	return std::find(first, last, value);
+}
+
+template<typename It, typename T>
+It
+find(It first, It last, const T& value, std::true_type)
+{
+	return first + (simd::find<T>(first, last, value) - first);
+}
+
+template<typename It, typename T>
+std::size_t
+count(It first, It last, const T& value, std::false_type)
+{
+	return static_cast<std::size_t>(std::count(first, last, value));
+}
+
+template<typename It, typename T>
+std::size_t
+count(It first, It last, const T& value, std::true_type)
+{
+	return simd::count<T>(first, last, value);
+}
+
+template<typename It1, typename It2>
+bool
+equal(It1 first1, It1 last1, It2 first2, std::false_type)
+{
+	return std::equal(first1, last1, first2);
+}
+
+template<typename It1, typename It2>
+bool
+equal(It1 first1, It1 last1, It2 first2, std::true_type)
+{
+	using T = std::remove_cv_t<std::remove_pointer_t<It1>>;
+	return simd::equal<T>(first1, last1, first2);
+}
+
+} // namespace detail
+
+// NOTE: Algorithms below behave like their std counterparts, but use
+//  vectorized kernels when given a contiguous range of arithmetic items.
+
+template<typename InputIt, typename T>
+InputIt
+find(InputIt first, InputIt last, const T& value)
+{
+	return detail::find(first, last, value,
+		detail::IsVectorizableRange<InputIt, T>{});
+}
+
+template<typename InputIt, typename T>
+std::size_t
+count(InputIt first, InputIt last, const T& value)
+{
+	return detail::count(first, last, value,
+		detail::IsVectorizableRange<InputIt, T>{});
+}
+
+template<typename InputIt, typename T>
+bool
+contains(InputIt first, InputIt last, const T& value)
+{
+	return (aisdi::find(first, last, value) != last);
+}
+
+template<typename Container, typename T>
+bool
+contains(const Container& container, const T& value)
+{
+	return aisdi::contains(container.begin(), container.end(), value);
+}
+
+template<typename InputIt1, typename InputIt2>
+bool
+equal(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+{
+	using T = typename std::iterator_traits<InputIt2>::value_type;
+	return detail::equal(first1, last1, first2,
+		std::integral_constant<bool,
+			detail::IsVectorizableRange<InputIt1, T>::value
+			&& detail::IsVectorizableRange<InputIt2, T>::value>{});
+}
+
+// Removes all items equal to value, like std::remove.
+// Gaps are located with aisdi::find, so the untouched runs between them
+// are scanned with vectorized kernels and moved as whole blocks.
+template<typename ForwardIt, typename T>
+ForwardIt
+remove(ForwardIt first, ForwardIt last, const T& value)
+{
+	first = aisdi::find(first, last, value);
+	if(first == last)
+	{
+		return last;
+	}
+
+	auto result = first;
+	for(auto pos = std::next(first); ; ++pos)
+	{
+		const auto next = aisdi::find(pos, last, value);
+		result = std::move(pos, next, result);
+		if(next == last)
+		{
+			return result;
+		}
+
+		pos = next;
+	}
+}
+
+} // namespace aisdi
+
+#endif
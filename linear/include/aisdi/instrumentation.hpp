@@ -0,0 +1,245 @@
+#ifndef AISDI_INSTRUMENTATION_HPP
+#define AISDI_INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// NOTE: Containers report their allocations and growth only when
+//  AISDI_INSTRUMENT is defined (CMake option of the same name). Otherwise
+//  all probes are empty inline functions, which are optimized away,
+//  and the registry stays empty.
+#if defined(AISDI_INSTRUMENT)
+#define AISDI_INSTRUMENTED 1
+#else
+#define AISDI_INSTRUMENTED 0
+#endif
+
+namespace aisdi {
+namespace instrumentation {
+
+// Counters shared by all instances of one container type.
+// Relaxed atomics, so containers may be used from many threads.
+struct Counters
+{
+	std::atomic<std::uint64_t> allocations{0};
+	std::atomic<std::uint64_t> deallocations{0};
+	std::atomic<std::uint64_t> allocatedBytes{0};
+	std::atomic<std::uint64_t> deallocatedBytes{0};
+	std::atomic<std::uint64_t> reallocations{0};
+	std::atomic<std::uint64_t> moves{0};
+	std::atomic<std::uint64_t> copies{0};
+	std::atomic<std::uint64_t> peakSize{0};
+	std::atomic<std::uint64_t> maxChainLength{0};
+};
+
+// Process-wide set of counters, one per container type
+class Registry
+{
+public:
+	static Registry&
+	instance()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	// Returns counters of given container type, creating them on first use.
+	// Returned reference stays valid for the whole lifetime of the process.
+	Counters&
+	counters(const std::string& container)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		auto& counters = _counters[container];
+		if(!counters)
+		{
+			counters = std::make_unique<Counters>();
+		}
+
+		return *counters;
+	}
+
+	// Zeroes all counters, e.g. before measuring a single request
+	void
+	reset()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		for(auto& entry : _counters)
+		{
+			auto& counters = *entry.second;
+			for(auto counter : {&counters.allocations, &counters.deallocations,
+				&counters.allocatedBytes, &counters.deallocatedBytes,
+				&counters.reallocations, &counters.moves, &counters.copies,
+				&counters.peakSize, &counters.maxChainLength})
+			{
+				counter->store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Writes all counters as a JSON object keyed by container type, e.g.
+	// {"Vector": {"allocations": 3, ..., "liveAllocations": 1, "liveBytes": 64}}
+	void
+	writeJson(std::ostream& out) const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		out << '{';
+		auto separator = "";
+		for(const auto& entry : _counters)
+		{
+			const auto& counters = *entry.second;
+			const auto load = [](const std::atomic<std::uint64_t>& counter)
+				{
+					return counter.load(std::memory_order_relaxed);
+				};
+
+			const auto allocations = load(counters.allocations);
+			const auto deallocations = load(counters.deallocations);
+			const auto allocatedBytes = load(counters.allocatedBytes);
+			const auto deallocatedBytes = load(counters.deallocatedBytes);
+
+			out << separator << '"' << entry.first << "\": {"
+				<< "\"allocations\": " << allocations
+				<< ", \"deallocations\": " << deallocations
+				<< ", \"liveAllocations\": " << (allocations - deallocations)
+				<< ", \"allocatedBytes\": " << allocatedBytes
+				<< ", \"deallocatedBytes\": " << deallocatedBytes
+				<< ", \"liveBytes\": " << (allocatedBytes - deallocatedBytes)
+				<< ", \"reallocations\": " << load(counters.reallocations)
+				<< ", \"moves\": " << load(counters.moves)
+				<< ", \"copies\": " << load(counters.copies)
+				<< ", \"peakSize\": " << load(counters.peakSize)
+				<< ", \"maxChainLength\": " << load(counters.maxChainLength)
+				<< '}';
+			separator = ", ";
+		}
+		out << '}';
+	}
+
+	std::string
+	toJson() const
+	{
+		std::ostringstream out;
+		writeJson(out);
+		return out.str();
+	}
+
+private:
+	Registry() = default;
+
+	mutable std::mutex _mutex;
+	std::map<std::string, std::unique_ptr<Counters>> _counters;
+};
+
+// Hooks called by containers. Tag names the container type:
+//  struct Tag { static const char* name() noexcept; };
+template<typename Tag>
+class Probe
+{
+public:
+#if AISDI_INSTRUMENTED
+	static void
+	allocated(std::size_t bytes) noexcept
+	{
+		add(counters().allocations, 1);
+		add(counters().allocatedBytes, bytes);
+	}
+
+	static void
+	deallocated(std::size_t bytes) noexcept
+	{
+		add(counters().deallocations, 1);
+		add(counters().deallocatedBytes, bytes);
+	}
+
+	// Memory block changed its size without being replaced
+	static void
+	resizedInPlace(std::size_t oldBytes, std::size_t newBytes) noexcept
+	{
+		if(newBytes > oldBytes)
+		{
+			add(counters().allocatedBytes, newBytes - oldBytes);
+		}
+		else
+		{
+			add(counters().deallocatedBytes, oldBytes - newBytes);
+		}
+	}
+
+	static void
+	reallocated() noexcept
+	{
+		add(counters().reallocations, 1);
+	}
+
+	static void
+	moved(std::size_t count) noexcept
+	{
+		add(counters().moves, count);
+	}
+
+	static void
+	copied(std::size_t count) noexcept
+	{
+		add(counters().copies, count);
+	}
+
+	static void
+	sized(std::size_t size) noexcept
+	{
+		raise(counters().peakSize, size);
+	}
+
+	static void
+	chained(std::size_t length) noexcept
+	{
+		raise(counters().maxChainLength, length);
+	}
+
+private:
+	static Counters&
+	counters() noexcept
+	{
+		static auto& counters = Registry::instance().counters(Tag::name());
+		return counters;
+	}
+
+	static void
+	add(std::atomic<std::uint64_t>& counter, std::size_t value) noexcept
+	{
+		counter.fetch_add(value, std::memory_order_relaxed);
+	}
+
+	static void
+	raise(std::atomic<std::uint64_t>& counter, std::size_t value) noexcept
+	{
+		auto current = counter.load(std::memory_order_relaxed);
+		while(current < value
+			&& !counter.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{}
+	}
+#else
+	static void allocated(std::size_t) noexcept {}
+	static void deallocated(std::size_t) noexcept {}
+	static void resizedInPlace(std::size_t, std::size_t) noexcept {}
+	static void reallocated() noexcept {}
+	static void moved(std::size_t) noexcept {}
+	static void copied(std::size_t) noexcept {}
+	static void sized(std::size_t) noexcept {}
+	static void chained(std::size_t) noexcept {}
+#endif
+};
+
+} // namespace instrumentation
+} // namespace aisdi
+
+#endif
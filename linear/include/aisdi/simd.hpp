@@ -0,0 +1,355 @@
+#ifndef AISDI_SIMD_HPP
+#define AISDI_SIMD_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+// NOTE: Vectorized kernels are available on x86-64 with GCC or Clang.
+//  SSE2 is a part of x86-64 baseline, so it is always used there,
+//  AVX2 is selected at runtime when processor supports it.
+//  Define AISDI_NO_SIMD to fall back to portable scalar loops everywhere.
+#if !defined(AISDI_NO_SIMD) && defined(__x86_64__) && defined(__GNUC__)
+#define AISDI_SIMD_X86 1
+#include <immintrin.h>
+#define AISDI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AISDI_SIMD_X86 0
+#endif
+
+namespace aisdi {
+namespace simd {
+
+// Types, which items may be compared lane by lane.
+// Long double has no vector counterpart, so it is left to the scalar loops.
+template<typename T>
+struct IsVectorizable
+	:	std::integral_constant<bool,
+			std::is_arithmetic<T>::value
+			&& (sizeof(T) == 1 || sizeof(T) == 2
+				|| sizeof(T) == 4 || sizeof(T) == 8)>
+{};
+
+namespace detail {
+
+template<typename T>
+const T*
+findScalar(const T* first, const T* last, const T& value)
+{
+	for(; first != last; ++first)
+	{
+		if(*first == value)
+		{
+			break;
+		}
+	}
+
+	return first;
+}
+
+template<typename T>
+std::size_t
+countScalar(const T* first, const T* last, const T& value)
+{
+	auto result = std::size_t{0};
+	for(; first != last; ++first)
+	{
+		if(*first == value)
+		{
+			++result;
+		}
+	}
+
+	return result;
+}
+
+template<typename T>
+bool
+equalScalar(const T* first1, const T* last1, const T* first2)
+{
+	for(; first1 != last1; ++first1, ++first2)
+	{
+		if(!(*first1 == *first2))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if AISDI_SIMD_X86
+
+template<std::size_t Size>
+struct SizeTag {};
+struct FloatTag {};
+struct DoubleTag {};
+
+// Selects lane comparison: integers are compared bitwise,
+// floating point numbers with IEEE semantics (NaN != NaN, -0 == +0).
+template<typename T>
+using LaneTag = std::conditional_t<std::is_same<T, float>::value, FloatTag,
+	std::conditional_t<std::is_same<T, double>::value, DoubleTag,
+		SizeTag<sizeof(T)>>>;
+
+inline bool
+hasAvx2()
+{
+	static const auto result = (__builtin_cpu_supports("avx2") != 0);
+	return result;
+}
+
+template<typename T>
+__m128i
+broadcast128(const T& value)
+{
+	constexpr auto Lanes = sizeof(__m128i) / sizeof(T);
+	alignas(__m128i) T lanes[Lanes];
+	for(auto& lane : lanes)
+	{
+		lane = value;
+	}
+
+	return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+}
+
+inline __m128i eq128(__m128i a, __m128i b, SizeTag<1>) { return _mm_cmpeq_epi8(a, b); }
+inline __m128i eq128(__m128i a, __m128i b, SizeTag<2>) { return _mm_cmpeq_epi16(a, b); }
+inline __m128i eq128(__m128i a, __m128i b, SizeTag<4>) { return _mm_cmpeq_epi32(a, b); }
+
+inline __m128i
+eq128(__m128i a, __m128i b, SizeTag<8>)
+{
+	// SSE2 has no 64-bit compare, so both halves have to match
+	const auto eq = _mm_cmpeq_epi32(a, b);
+	return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+inline __m128i
+eq128(__m128i a, __m128i b, FloatTag)
+{
+	return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+inline __m128i
+eq128(__m128i a, __m128i b, DoubleTag)
+{
+	return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+// Returns one bit per byte of each matching lane
+template<typename T>
+unsigned
+mask128(const T* items, __m128i needle)
+{
+	const auto lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items));
+	return static_cast<unsigned>(_mm_movemask_epi8(eq128(lanes, needle, LaneTag<T>{})));
+}
+
+template<typename T>
+const T*
+findSse2(const T* first, const T* last, const T& value)
+{
+	constexpr auto Lanes = static_cast<std::ptrdiff_t>(sizeof(__m128i) / sizeof(T));
+	const auto needle = broadcast128(value);
+	for(; (last - first) >= Lanes; first += Lanes)
+	{
+		const auto mask = mask128(first, needle);
+		if(mask != 0)
+		{
+			return first + (static_cast<unsigned>(__builtin_ctz(mask)) / sizeof(T));
+		}
+	}
+
+	return findScalar(first, last, value);
+}
+
+template<typename T>
+std::size_t
+countSse2(const T* first, const T* last, const T& value)
+{
+	constexpr auto Lanes = static_cast<std::ptrdiff_t>(sizeof(__m128i) / sizeof(T));
+	const auto needle = broadcast128(value);
+	auto bits = std::size_t{0};
+	for(; (last - first) >= Lanes; first += Lanes)
+	{
+		bits += static_cast<std::size_t>(__builtin_popcount(mask128(first, needle)));
+	}
+
+	return (bits / sizeof(T)) + countScalar(first, last, value);
+}
+
+template<typename T>
+bool
+equalSse2(const T* first1, const T* last1, const T* first2)
+{
+	constexpr auto Lanes = static_cast<std::ptrdiff_t>(sizeof(__m128i) / sizeof(T));
+	constexpr auto AllLanes = 0xFFFFu;
+	for(; (last1 - first1) >= Lanes; first1 += Lanes, first2 += Lanes)
+	{
+		const auto other = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first2));
+		if(mask128(first1, other) != AllLanes)
+		{
+			return false;
+		}
+	}
+
+	return equalScalar(first1, last1, first2);
+}
+
+template<typename T>
+AISDI_TARGET_AVX2 __m256i
+broadcast256(const T& value)
+{
+	constexpr auto Lanes = sizeof(__m256i) / sizeof(T);
+	alignas(__m256i) T lanes[Lanes];
+	for(auto& lane : lanes)
+	{
+		lane = value;
+	}
+
+	return _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+}
+
+AISDI_TARGET_AVX2 inline __m256i eq256(__m256i a, __m256i b, SizeTag<1>) { return _mm256_cmpeq_epi8(a, b); }
+AISDI_TARGET_AVX2 inline __m256i eq256(__m256i a, __m256i b, SizeTag<2>) { return _mm256_cmpeq_epi16(a, b); }
+AISDI_TARGET_AVX2 inline __m256i eq256(__m256i a, __m256i b, SizeTag<4>) { return _mm256_cmpeq_epi32(a, b); }
+AISDI_TARGET_AVX2 inline __m256i eq256(__m256i a, __m256i b, SizeTag<8>) { return _mm256_cmpeq_epi64(a, b); }
+
+AISDI_TARGET_AVX2 inline __m256i
+eq256(__m256i a, __m256i b, FloatTag)
+{
+	return _mm256_castps_si256(
+		_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+}
+
+AISDI_TARGET_AVX2 inline __m256i
+eq256(__m256i a, __m256i b, DoubleTag)
+{
+	return _mm256_castpd_si256(
+		_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+}
+
+template<typename T>
+AISDI_TARGET_AVX2 unsigned
+mask256(const T* items, __m256i needle)
+{
+	const auto lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+	return static_cast<unsigned>(_mm256_movemask_epi8(eq256(lanes, needle, LaneTag<T>{})));
+}
+
+template<typename T>
+AISDI_TARGET_AVX2 const T*
+findAvx2(const T* first, const T* last, const T& value)
+{
+	constexpr auto Lanes = static_cast<std::ptrdiff_t>(sizeof(__m256i) / sizeof(T));
+	const auto needle = broadcast256(value);
+	for(; (last - first) >= Lanes; first += Lanes)
+	{
+		const auto mask = mask256(first, needle);
+		if(mask != 0)
+		{
+			return first + (static_cast<unsigned>(__builtin_ctz(mask)) / sizeof(T));
+		}
+	}
+
+	return findScalar(first, last, value);
+}
+
+template<typename T>
+AISDI_TARGET_AVX2 std::size_t
+countAvx2(const T* first, const T* last, const T& value)
+{
+	constexpr auto Lanes = static_cast<std::ptrdiff_t>(sizeof(__m256i) / sizeof(T));
+	const auto needle = broadcast256(value);
+	auto bits = std::size_t{0};
+	for(; (last - first) >= Lanes; first += Lanes)
+	{
+		bits += static_cast<std::size_t>(__builtin_popcount(mask256(first, needle)));
+	}
+
+	return (bits / sizeof(T)) + countScalar(first, last, value);
+}
+
+template<typename T>
+AISDI_TARGET_AVX2 bool
+equalAvx2(const T* first1, const T* last1, const T* first2)
+{
+	constexpr auto Lanes = static_cast<std::ptrdiff_t>(sizeof(__m256i) / sizeof(T));
+	constexpr auto AllLanes = 0xFFFFFFFFu;
+	for(; (last1 - first1) >= Lanes; first1 += Lanes, first2 += Lanes)
+	{
+		const auto other = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first2));
+		if(mask256(first1, other) != AllLanes)
+		{
+			return false;
+		}
+	}
+
+	return equalScalar(first1, last1, first2);
+}
+
+#endif // AISDI_SIMD_X86
+
+} // namespace detail
+
+// Returns pointer to the first item equal to value, or last
+template<typename T>
+const T*
+find(const T* first, const T* last, const T& value)
+{
+	static_assert(IsVectorizable<T>::value, "Type is not vectorizable");
+
+#if AISDI_SIMD_X86
+	if(detail::hasAvx2())
+	{
+		return detail::findAvx2(first, last, value);
+	}
+
+	return detail::findSse2(first, last, value);
+#else
+	return detail::findScalar(first, last, value);
+#endif
+}
+
+// Returns number of items equal to value
+template<typename T>
+std::size_t
+count(const T* first, const T* last, const T& value)
+{
+	static_assert(IsVectorizable<T>::value, "Type is not vectorizable");
+
+#if AISDI_SIMD_X86
+	if(detail::hasAvx2())
+	{
+		return detail::countAvx2(first, last, value);
+	}
+
+	return detail::countSse2(first, last, value);
+#else
+	return detail::countScalar(first, last, value);
+#endif
+}
+
+// Checks whether [first1, last1) and range starting at first2 are equal
+template<typename T>
+bool
+equal(const T* first1, const T* last1, const T* first2)
+{
+	static_assert(IsVectorizable<T>::value, "Type is not vectorizable");
+
+#if AISDI_SIMD_X86
+	if(detail::hasAvx2())
+	{
+		return detail::equalAvx2(first1, last1, first2);
+	}
+
+	return detail::equalSse2(first1, last1, first2);
+#else
+	return detail::equalScalar(first1, last1, first2);
+#endif
+}
+
+} // namespace simd
+} // namespace aisdi
+
+#endif
@@ -23,6 +23,18 @@ destroy(ForwardIt first, ForwardIt last)
 	}
 }
 
+// Hints processor to start loading memory at address, which is going to be
+// read soon. Does nothing on compilers without a prefetch builtin.
+inline void
+prefetch(const void* address) noexcept
+{
+#if defined(__GNUC__)
+	__builtin_prefetch(address);
+#else
+	static_cast<void>(address);
+#endif
+}
+
 } // namespace util
 } // namespace aisdi
 
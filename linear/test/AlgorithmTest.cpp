@@ -0,0 +1,179 @@
+#define BOOST_TEST_MODULE AlgorithmTest
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/algorithm.hpp"
+#include "aisdi/Vector.hpp"
+
+using TestTypes = boost::mpl::list<char, unsigned char, short, int,
+                                   unsigned int, long, std::uint64_t,
+                                   float, double>;
+
+namespace
+{
+
+// Long enough to cover a few whole vectors and every kind of scalar tail
+constexpr auto MaxLength = 70;
+
+template<typename T>
+aisdi::Vector<T>
+makeVector(int length)
+{
+	auto vector = aisdi::Vector<T>{};
+	for(auto i = 0; i < length; ++i)
+	{
+		vector.append(static_cast<T>(i % 7));
+	}
+
+	return vector;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenFinding_ThenResultIsSameAsStd,
+	T, TestTypes)
+{
+	for(auto length = 0; length < MaxLength; ++length)
+	{
+		const auto vector = makeVector<T>(length);
+		for(auto value = 0; value < 8; ++value)
+		{
+			const auto item = static_cast<T>(value);
+			BOOST_CHECK(aisdi::find(vector.begin(), vector.end(), item)
+				== std::find(vector.begin(), vector.end(), item));
+			BOOST_CHECK(aisdi::contains(vector, item)
+				== (std::find(vector.begin(), vector.end(), item) != vector.end()));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenItemAtEachPosition_WhenFinding_ThenItIsFound,
+	T, TestTypes)
+{
+	for(auto length = 1; length < MaxLength; ++length)
+	{
+		for(auto index = 0; index < length; ++index)
+		{
+			auto vector = aisdi::Vector<T>{};
+			vector.resize(static_cast<std::size_t>(length));
+			std::fill(vector.begin(), vector.end(), T{1});
+			*(vector.begin() + index) = T{2};
+
+			BOOST_CHECK(aisdi::find(vector.begin(), vector.end(), T{2})
+				== (vector.begin() + index));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenCounting_ThenResultIsSameAsStd,
+	T, TestTypes)
+{
+	for(auto length = 0; length < MaxLength; ++length)
+	{
+		const auto vector = makeVector<T>(length);
+		for(auto value = 0; value < 8; ++value)
+		{
+			const auto item = static_cast<T>(value);
+			const auto expected = std::count(vector.begin(), vector.end(), item);
+			BOOST_CHECK(aisdi::count(vector.begin(), vector.end(), item)
+				== static_cast<std::size_t>(expected));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainersDifferingAtEachPosition_WhenCompared_ThenTheyAreNotEqual,
+	T, TestTypes)
+{
+	for(auto length = 1; length < MaxLength; ++length)
+	{
+		const auto vector = makeVector<T>(length);
+		BOOST_CHECK(vector == makeVector<T>(length));
+
+		for(auto index = 0; index < length; ++index)
+		{
+			auto other = vector;
+			*(other.begin() + index) = T{9};
+
+			BOOST_CHECK(vector != other);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenFloatingPointItems_WhenCompared_ThenIeeeSemanticsIsKept)
+{
+	const auto nan = std::numeric_limits<double>::quiet_NaN();
+	auto vector1 = makeVector<double>(40);
+	auto vector2 = makeVector<double>(40);
+
+	*(vector1.begin() + 35) = 0.0;
+	*(vector2.begin() + 35) = -0.0;
+	BOOST_CHECK(vector1 == vector2);
+
+	*(vector1.begin() + 3) = nan;
+	*(vector2.begin() + 3) = nan;
+	BOOST_CHECK(vector1 != vector2);
+	BOOST_CHECK(!aisdi::contains(vector1, nan));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenRemoving_ThenResultIsSameAsStd,
+	T, TestTypes)
+{
+	for(auto length = 0; length < MaxLength; ++length)
+	{
+		auto vector = makeVector<T>(length);
+		auto expected = vector;
+
+		const auto item = static_cast<T>(length % 7);
+		vector.erase(aisdi::remove(vector.begin(), vector.end(), item), vector.end());
+		expected.erase(std::remove(expected.begin(), expected.end(), item), expected.end());
+
+		BOOST_CHECK(vector == expected);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenNotArithmeticItems_WhenUsingAlgorithms_ThenStdFallbackIsUsed)
+{
+	const auto vector = aisdi::Vector<std::string>{"a", "b", "a"};
+
+	BOOST_CHECK(aisdi::find(vector.begin(), vector.end(), "b") == (vector.begin() + 1));
+	BOOST_CHECK(aisdi::count(vector.begin(), vector.end(), "a") == 2);
+	BOOST_CHECK(!aisdi::contains(vector, "c"));
+}
+
+#if AISDI_SIMD_X86
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenSse2Kernels_WhenUsed_ThenResultsAreSameAsScalar,
+	T, TestTypes)
+{
+	namespace detail = aisdi::simd::detail;
+
+	for(auto length = 0; length < MaxLength; ++length)
+	{
+		const auto vector = makeVector<T>(length);
+		const auto first = vector.data();
+		const auto last = vector.data() + length;
+		const auto item = static_cast<T>(length % 7);
+
+		BOOST_CHECK(detail::findSse2(first, last, item)
+			== detail::findScalar(first, last, item));
+		BOOST_CHECK(detail::countSse2(first, last, item)
+			== detail::countScalar(first, last, item));
+		BOOST_CHECK(detail::equalSse2(first, last, first));
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+#define BOOST_TEST_MODULE AlignedStorageTest
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/AlignedStorage.hpp"
+#include "aisdi/Vector.hpp"
+
+using TestTypes = boost::mpl::list<float, std::uint32_t, unsigned char, double>;
+
+template<typename T, std::size_t Alignment>
+using AlignedVector = aisdi::Vector<T, aisdi::AlignedStorage<T, Alignment>>;
+
+template<typename Pointer>
+bool
+isAligned(Pointer pointer, std::size_t alignment)
+{
+	return (reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	WhenDefaultConstructing_ThenNothingIsAllocated,
+	T, TestTypes)
+{
+	const auto vector = AlignedVector<T, 64>{};
+
+	BOOST_CHECK(vector.empty());
+	BOOST_CHECK(vector.capacity() == 0);
+	BOOST_CHECK(vector.data() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	WhenAppending_ThenDataIsAlwaysAligned,
+	T, TestTypes)
+{
+	auto vector32 = AlignedVector<T, 32>{};
+	auto vector64 = AlignedVector<T, 64>{};
+
+	for(auto i = 0; i < 1000; ++i)
+	{
+		vector32.append(static_cast<T>(i % 100));
+		vector64.append(static_cast<T>(i % 100));
+
+		BOOST_CHECK(isAligned(vector32.data(), 32));
+		BOOST_CHECK(isAligned(vector64.data(), 64));
+	}
+
+	BOOST_CHECK(vector64.size() == 1000);
+	BOOST_CHECK(vector64.back() == static_cast<T>(99));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	WhenReserving_ThenCapacityIsPaddedToWholeBlocks,
+	T, TestTypes)
+{
+	auto vector = AlignedVector<T, 64>{};
+
+	vector.reserve(1);
+
+	BOOST_CHECK(vector.capacity() == 64 / sizeof(T));
+	BOOST_CHECK(isAligned(vector.data(), 64));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenPadding_WhenAppending_ThenItemsAreNotRelocated,
+	T, TestTypes)
+{
+	auto vector = AlignedVector<T, 64>{T{1}};
+	const auto data = vector.data();
+
+	while(vector.size() < vector.capacity())
+	{
+		vector.append(T{2});
+	}
+
+	BOOST_CHECK(vector.data() == data);
+	BOOST_CHECK(vector.front() == T{1});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenAlignedContainer_WhenSearching_ThenVectorizedAlgorithmsFindItems,
+	T, TestTypes)
+{
+	auto vector = AlignedVector<T, 32>{};
+	for(auto i = 0; i < 100; ++i)
+	{
+		vector.append(static_cast<T>(i % 10));
+	}
+
+	const auto pos = aisdi::find(vector.cbegin(), vector.cend(), T{7});
+
+	BOOST_CHECK(pos == vector.cbegin() + 7);
+	BOOST_CHECK(aisdi::count(vector.cbegin(), vector.cend(), T{3}) == 10);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenNonTrivialItems_WhenCopying_ThenItemsAreCopied)
+{
+	auto vector = AlignedVector<std::string, 64>{"foo", "bar"};
+	vector.append("baz");
+
+	const auto copy = vector;
+
+	BOOST_CHECK(copy == vector);
+	BOOST_CHECK(copy.back() == "baz");
+	BOOST_CHECK(isAligned(copy.data(), 64));
+}
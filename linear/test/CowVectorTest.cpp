@@ -0,0 +1,148 @@
+#define BOOST_TEST_MODULE CowVectorTest
+#include <boost/test/unit_test.hpp>
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/CowVector.hpp"
+
+using TestTypes = boost::mpl::list<int, long, unsigned char>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	WhenDefaultConstructing_ThenItIsEmpty,
+	T, TestTypes)
+{
+	const auto vector = aisdi::CowVector<T>{};
+
+	BOOST_CHECK(vector.empty());
+	BOOST_CHECK(vector.begin() == vector.end());
+	BOOST_CHECK(vector.unique());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenCopying_ThenBufferIsShared,
+	T, TestTypes)
+{
+	const auto vector1 = aisdi::CowVector<T>{1, 2, 3};
+	const auto vector2 = vector1;
+
+	BOOST_CHECK(vector2.shares(vector1));
+	BOOST_CHECK(vector2.cbegin() == vector1.cbegin());
+	BOOST_CHECK(vector1 == vector2);
+	BOOST_CHECK(!vector1.unique());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenSnapshot_WhenModifyingOriginal_ThenSnapshotIsNotChanged,
+	T, TestTypes)
+{
+	auto vector = aisdi::CowVector<T>{1, 2, 3};
+	const auto snapshot = vector;
+
+	vector.append(T{4});
+	vector.front() = T{5};
+
+	BOOST_CHECK(!vector.shares(snapshot));
+	BOOST_CHECK(vector.unique());
+	BOOST_CHECK(snapshot.unique());
+	BOOST_CHECK((snapshot == aisdi::CowVector<T>{1, 2, 3}));
+	BOOST_CHECK((vector == aisdi::CowVector<T>{5, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenUniqueContainer_WhenModifying_ThenBufferIsNotCopied,
+	T, TestTypes)
+{
+	auto vector = aisdi::CowVector<T>{1, 2, 3};
+	vector.reserve(10);
+	const auto data = vector.cbegin();
+
+	vector.append(T{4});
+
+	BOOST_CHECK(vector.cbegin() == data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenSnapshot_WhenRemovingMissingValue_ThenBufferIsStillShared,
+	T, TestTypes)
+{
+	auto vector = aisdi::CowVector<T>{1, 2, 3};
+	const auto snapshot = vector;
+
+	BOOST_CHECK(vector.remove_value_unordered(T{7}) == 0);
+	BOOST_CHECK(vector.erase_if([](const auto& item) { return item > 5; }) == 0);
+	BOOST_CHECK(vector.shares(snapshot));
+
+	BOOST_CHECK(vector.remove_value_unordered(T{2}) == 1);
+	BOOST_CHECK(!vector.shares(snapshot));
+	BOOST_CHECK(snapshot.size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenSnapshot_WhenErasingWithItsIterator_ThenProperItemIsErased,
+	T, TestTypes)
+{
+	auto vector = aisdi::CowVector<T>{1, 2, 3, 4};
+	const auto snapshot = vector;
+
+	const auto pos = vector.erase(std::next(vector.cbegin()));
+	vector.insert(vector.cend(), snapshot.front());
+
+	BOOST_CHECK(*pos == T{3});
+	BOOST_CHECK((vector == aisdi::CowVector<T>{1, 3, 4, 1}));
+	BOOST_CHECK((snapshot == aisdi::CowVector<T>{1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenSnapshot_WhenClearing_ThenOnlyOriginalIsCleared,
+	T, TestTypes)
+{
+	auto vector = aisdi::CowVector<T>{1, 2, 3};
+	const auto snapshot = vector;
+
+	vector.clear();
+
+	BOOST_CHECK(vector.empty());
+	BOOST_CHECK(snapshot.size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenSnapshotsReadByOtherThreads_WhenTheyAreDropped_ThenOriginalIsModifiedInPlace)
+{
+	auto vector = aisdi::CowVector<int>{1, 2, 3, 4};
+	const auto buffer = vector.cbegin();
+
+	auto sums = std::vector<int>(4);
+	auto readers = std::vector<std::thread>{};
+	for(auto& sum : sums)
+	{
+		readers.emplace_back([snapshot = vector, &sum]() mutable
+			{
+				sum = std::accumulate(snapshot.cbegin(), snapshot.cend(), 0);
+				snapshot = aisdi::CowVector<int>{};
+			});
+	}
+
+	// Readers are still running, so their reads must be ordered by the
+	// reference count alone
+	while(!vector.unique())
+	{
+		std::this_thread::yield();
+	}
+
+	vector.front() = 42;
+	BOOST_CHECK(vector.cbegin() == buffer);
+
+	for(auto& reader : readers)
+	{
+		reader.join();
+	}
+
+	for(const auto sum : sums)
+	{
+		BOOST_CHECK(sum == 10);
+	}
+}
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE InstrumentationTest
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include "aisdi/instrumentation.hpp"
+#include "aisdi/List.hpp"
+#include "aisdi/Vector.hpp"
+
+// NOTE: This module is built with AISDI_INSTRUMENT defined
+static_assert(AISDI_INSTRUMENTED, "Instrumentation should be enabled");
+
+namespace {
+
+using aisdi::instrumentation::Counters;
+using aisdi::instrumentation::Registry;
+
+Counters&
+counters(const std::string& container)
+{
+	return Registry::instance().counters(container);
+}
+
+struct ResetRegistry
+{
+	ResetRegistry()
+	{
+		Registry::instance().reset();
+	}
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(Instrumentation, ResetRegistry)
+
+BOOST_AUTO_TEST_CASE(
+	GivenEmptyVector_WhenAppending_ThenReallocationsAreCounted)
+{
+	{
+		auto vector = aisdi::Vector<int>{};
+		for(auto i = 0; i < 10; ++i)
+		{
+			vector.append(i);
+		}
+	}
+
+	// Capacities: 2, 6, 14
+	const auto& vector = counters("Vector");
+	BOOST_CHECK(vector.allocations == 3);
+	BOOST_CHECK(vector.reallocations == 3);
+	BOOST_CHECK(vector.allocatedBytes == (2 + 6 + 14) * sizeof(int));
+	BOOST_CHECK(vector.deallocations == vector.allocations.load());
+	BOOST_CHECK(vector.deallocatedBytes == vector.allocatedBytes.load());
+	BOOST_CHECK(vector.peakSize == 10);
+	BOOST_CHECK(vector.copies == 10);
+	BOOST_CHECK(vector.moves == (2 + 6));
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenVector_WhenCopying_ThenCopiesAreCounted)
+{
+	const auto vector1 = aisdi::Vector<int>{1, 2, 3};
+	const auto vector2 = vector1;
+
+	const auto& vector = counters("Vector");
+	BOOST_CHECK(vector.allocations == 2);
+	BOOST_CHECK(vector.deallocations == 0);
+	BOOST_CHECK(vector.copies == 6);
+	BOOST_CHECK(vector.reallocations == 0);
+	static_cast<void>(vector2);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenList_WhenErasingNodes_ThenLiveNodesAreCounted)
+{
+	auto list = aisdi::List<int>{1, 2, 3, 4};
+	list.popBack();
+	list.append(5);
+	list.append(6);
+
+	const auto& counters = ::counters("List");
+	BOOST_CHECK(counters.allocations == 6);
+	BOOST_CHECK(counters.deallocations == 1);
+	BOOST_CHECK(counters.allocations - counters.deallocations == list.size());
+	BOOST_CHECK(counters.peakSize == 5);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenUsedContainers_WhenWritingJson_ThenAllCountersAreListed)
+{
+	auto list = aisdi::List<int>{1};
+	auto vector = aisdi::Vector<int>{1, 2};
+
+	const auto json = Registry::instance().toJson();
+
+	BOOST_CHECK(json.front() == '{');
+	BOOST_CHECK(json.back() == '}');
+	BOOST_CHECK(json.find("\"List\": {\"allocations\": 1, \"deallocations\": 0, "
+		"\"liveAllocations\": 1") != std::string::npos);
+	BOOST_CHECK(json.find("\"Vector\": {\"allocations\": 1") != std::string::npos);
+	BOOST_CHECK(json.find("\"maxChainLength\": 0") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -588,3 +588,32 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(
 	BOOST_CHECK(afterLastRemoved == list.end());
 	BOOST_CHECK(list.empty());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenTwoContainers_WhenSplicingItem_ThenItIsMovedBetweenThem,
+	T, TestTypes)
+{
+	auto list1 = aisdi::List<T>{T{1}, T{2}, T{3}};
+	auto list2 = aisdi::List<T>{T{4}, T{5}};
+	const auto item = (list1.begin() + 1);
+
+	list2.splice(list2.begin() + 1, list1, item);
+
+	BOOST_CHECK(list1 == (aisdi::List<T>{T{1}, T{3}}));
+	BOOST_CHECK(list2 == (aisdi::List<T>{T{4}, T{2}, T{5}}));
+	BOOST_CHECK(list2.begin() + 1 == item);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenSplicingItemWithinIt_ThenItemsAreReordered,
+	T, TestTypes)
+{
+	auto list = aisdi::List<T>{T{1}, T{2}, T{3}};
+
+	list.splice(list.begin(), list, list.begin() + 2);
+	list.splice(list.end(), list, list.begin() + 1);
+	list.splice(list.begin() + 1, list, list.begin() + 1);
+
+	BOOST_CHECK(list == (aisdi::List<T>{T{3}, T{2}, T{1}}));
+	BOOST_CHECK(list.size() == 3);
+}
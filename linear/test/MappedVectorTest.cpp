@@ -0,0 +1,240 @@
+#define BOOST_TEST_MODULE MappedVectorTest
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <boost/mpl/list.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "aisdi/MappedVector.hpp"
+
+using TestTypes = boost::mpl::list<int, std::uint64_t, unsigned char>;
+
+namespace
+{
+
+struct TemporaryFile
+{
+	TemporaryFile()
+	{
+		char name[] = "/tmp/aisdi_MappedVectorTest_XXXXXX";
+		const auto fd = mkstemp(name);
+		BOOST_REQUIRE(fd >= 0);
+		close(fd);
+		path = name;
+	}
+
+	~TemporaryFile()
+	{
+		std::remove(path.c_str());
+	}
+
+	std::string path;
+};
+
+struct Edge
+{
+	unsigned int u;
+	unsigned int v;
+};
+
+struct Triangle
+{
+	unsigned int u;
+	unsigned int v;
+	unsigned int w;
+};
+
+// Lowers the address space limit close to the current usage, so any
+// large mapping fails, and restores it on scope exit
+struct AddressSpaceLimit
+{
+	AddressSpaceLimit()
+	{
+		BOOST_REQUIRE(getrlimit(RLIMIT_AS, &previous) == 0);
+
+		auto pages = 0ul;
+		std::ifstream{"/proc/self/statm"} >> pages;
+		BOOST_REQUIRE(pages > 0);
+
+		const auto usedBytes = pages * static_cast<unsigned long>(sysconf(_SC_PAGESIZE));
+		auto limited = previous;
+		limited.rlim_cur = static_cast<rlim_t>(usedBytes + (64ul << 20));
+		BOOST_REQUIRE(setrlimit(RLIMIT_AS, &limited) == 0);
+	}
+
+	~AddressSpaceLimit()
+	{
+		setrlimit(RLIMIT_AS, &previous);
+	}
+
+	rlimit previous;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenEmptyFile_WhenOpening_ThenItIsEmpty,
+	T, TestTypes)
+{
+	const auto file = TemporaryFile{};
+	const auto vector = aisdi::MappedVector<T>{file.path};
+
+	BOOST_CHECK(vector.empty());
+	BOOST_CHECK(vector.begin() == vector.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenAppendedItems_WhenReopening_ThenTheyAreKept,
+	T, TestTypes)
+{
+	const auto file = TemporaryFile{};
+	{
+		auto vector = aisdi::MappedVector<T>{file.path};
+		for(auto i = 0; i < 1000; ++i)
+		{
+			vector.append(static_cast<T>(i));
+		}
+	}
+
+	const auto vector = aisdi::MappedVector<T>{file.path};
+
+	BOOST_REQUIRE(vector.size() == 1000);
+	for(auto i = 0; i < 1000; ++i)
+	{
+		BOOST_CHECK(vector[static_cast<std::size_t>(i)] == static_cast<T>(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenFile_WhenOpeningPrivately_ThenChangesAreNotWrittenBack,
+	T, TestTypes)
+{
+	const auto file = TemporaryFile{};
+	{
+		auto vector = aisdi::MappedVector<T>{file.path};
+		vector.append(T{1});
+		vector.append(T{2});
+	}
+
+	{
+		auto vector = aisdi::MappedVector<T>{file.path, aisdi::MappedVector<T>::Mode::Private};
+		vector.front() = T{3};
+		vector.popBack();
+		BOOST_CHECK(vector.size() == 1);
+		BOOST_CHECK(vector.front() == T{3});
+		BOOST_CHECK_THROW(vector.reserve(vector.capacity() + 1), std::logic_error);
+	}
+
+	const auto vector = aisdi::MappedVector<T>{file.path};
+	BOOST_CHECK(vector.size() == 2);
+	BOOST_CHECK(vector.front() == T{1});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenFileOfOtherItems_WhenOpening_ThenExceptionIsThrown,
+	T, TestTypes)
+{
+	const auto file = TemporaryFile{};
+	{
+		auto vector = aisdi::MappedVector<Triangle>{file.path};
+		vector.append(Triangle{1, 2, 3});
+	}
+
+	BOOST_CHECK_THROW(aisdi::MappedVector<T>{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenNotMappedVectorFile_WhenOpening_ThenExceptionIsThrown)
+{
+	const auto file = TemporaryFile{};
+	{
+		auto stream = std::fopen(file.path.c_str(), "w");
+		BOOST_REQUIRE(stream);
+		for(auto i = 0; i < 100; ++i)
+		{
+			std::fputs("0 1\n", stream);
+		}
+
+		std::fclose(stream);
+	}
+
+	BOOST_CHECK_THROW(aisdi::MappedVector<int>{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenContainer_WhenResizingAndShrinking_ThenItemsAreKept)
+{
+	const auto file = TemporaryFile{};
+	auto vector = aisdi::MappedVector<Edge>{file.path};
+	vector.append(Edge{1, 2});
+
+	vector.resize(100);
+	BOOST_CHECK(vector.size() == 100);
+	BOOST_CHECK(vector.back().u == 0);
+
+	vector.resize(2);
+	vector.shrink_to_fit();
+	vector.sync();
+	BOOST_CHECK(vector.capacity() == 2);
+	BOOST_CHECK(vector.front().u == 1);
+	BOOST_CHECK(vector.front().v == 2);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenContainer_WhenMappingFailsOnGrowing_ThenItIsUnchanged)
+{
+	const auto file = TemporaryFile{};
+	auto vector = aisdi::MappedVector<int>{file.path};
+	for(auto i = 0; i < 10; ++i)
+	{
+		vector.append(i);
+	}
+	const auto capacity = vector.capacity();
+
+	{
+		const auto limit = AddressSpaceLimit{};
+		BOOST_CHECK_THROW(vector.reserve(std::size_t{1} << 28), std::system_error);
+	}
+
+	BOOST_CHECK(vector.capacity() == capacity);
+	BOOST_REQUIRE(vector.size() == 10);
+	BOOST_CHECK(vector.back() == 9);
+
+	vector.append(10);
+	BOOST_CHECK(vector.size() == 11);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenMovedFromContainer_WhenUsingIt_ThenItIsEmpty)
+{
+	const auto file = TemporaryFile{};
+	auto vector = aisdi::MappedVector<int>{file.path};
+	vector.append(42);
+
+	auto other = std::move(vector);
+	auto assigned = aisdi::MappedVector<int>{file.path};
+	assigned = std::move(other);
+
+	for(auto* moved : {&vector, &other})
+	{
+		BOOST_CHECK(moved->empty());
+		BOOST_CHECK(moved->size() == 0);
+		BOOST_CHECK(moved->capacity() == 0);
+		BOOST_CHECK(moved->begin() == moved->end());
+		moved->clear();
+		moved->sync();
+	}
+
+	BOOST_REQUIRE(assigned.size() == 1);
+	BOOST_CHECK(assigned.front() == 42);
+}
@@ -0,0 +1,101 @@
+#define BOOST_TEST_MODULE MmapStorageTest
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/MmapStorage.hpp"
+#include "aisdi/Vector.hpp"
+
+using TestTypes = boost::mpl::list<int, std::uint64_t, unsigned char>;
+
+constexpr auto ReservedBytes = (std::size_t{1} << 24);
+
+template<typename T>
+using SmallPagesVector = aisdi::Vector<T, aisdi::MmapStorage<T, ReservedBytes, false>>;
+
+template<typename T>
+using HugePagesVector = aisdi::Vector<T, aisdi::MmapStorage<T, ReservedBytes, true>>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	WhenDefaultConstructing_ThenNothingIsMapped,
+	T, TestTypes)
+{
+	const auto vector = SmallPagesVector<T>{};
+
+	BOOST_CHECK(vector.empty());
+	BOOST_CHECK(vector.capacity() == 0);
+	BOOST_CHECK(vector.data() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenReservation_WhenAppending_ThenItemsAreNotRelocated,
+	T, TestTypes)
+{
+	auto vector = SmallPagesVector<T>{};
+	vector.append(T{0});
+	const auto data = vector.data();
+
+	const auto count = (ReservedBytes / sizeof(T)) / 2;
+	for(auto i = std::size_t{1}; i < count; ++i)
+	{
+		vector.append(static_cast<T>(i));
+	}
+
+	BOOST_CHECK(vector.data() == data);
+	BOOST_CHECK(vector.size() == count);
+	BOOST_CHECK(vector.back() == static_cast<T>(count - 1));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenExhaustedReservation_WhenAppending_ThenItemsAreRelocated,
+	T, TestTypes)
+{
+	auto vector = SmallPagesVector<T>{};
+	const auto count = (ReservedBytes / sizeof(T)) + 1;
+	for(auto i = std::size_t{0}; i < count; ++i)
+	{
+		vector.append(static_cast<T>(i));
+	}
+
+	BOOST_CHECK(vector.size() == count);
+	BOOST_CHECK(vector.front() == T{0});
+	BOOST_CHECK(vector.back() == static_cast<T>(count - 1));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenLargeContainer_WhenShrinking_ThenPagesAreReturnedInPlace,
+	T, TestTypes)
+{
+	auto vector = SmallPagesVector<T>{};
+	vector.resize(ReservedBytes / sizeof(T) / 2);
+	const auto data = vector.data();
+	const auto capacity = vector.capacity();
+
+	vector.resize(3);
+	vector.shrink_to_fit();
+
+	BOOST_CHECK(vector.data() == data);
+	BOOST_CHECK(vector.capacity() < capacity);
+	BOOST_CHECK(vector.capacity() >= 3);
+
+	vector.resize(capacity);
+	BOOST_CHECK(vector.data() == data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenCopying_ThenTheyAreEqual,
+	T, TestTypes)
+{
+	auto vector1 = HugePagesVector<T>{1, 2, 3};
+	const auto vector2 = vector1;
+
+	BOOST_CHECK(vector1 == vector2);
+	BOOST_CHECK(vector1.data() != vector2.data());
+
+	auto vector3 = HugePagesVector<T>{};
+	vector3 = std::move(vector1);
+	BOOST_CHECK(vector3 == vector2);
+	BOOST_CHECK(vector1.empty());
+}
@@ -0,0 +1,319 @@
+#define BOOST_TEST_MODULE StaticVectorTest
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/StaticVector.hpp"
+
+using TestTypes = boost::mpl::list<int, long, unsigned char>;
+
+constexpr auto Capacity = std::size_t{8};
+
+template<typename T>
+using TestVector = aisdi::StaticVector<T, Capacity>;
+
+namespace
+{
+
+constexpr int
+sumOfAppended()
+{
+	auto vector = aisdi::StaticVector<int, 4>{};
+	vector.append(1);
+	vector.append(2);
+	vector.prepend(3);
+	vector.popFront();
+
+	auto sum = 0;
+	for(const auto item : vector)
+	{
+		sum += item;
+	}
+
+	return sum;
+}
+
+// Item, which counts its live instances and throws from the copy
+// constructor once the given number of copies has been made
+struct ThrowingItem
+{
+	static int instances;
+	static int copiesLeft;
+
+	ThrowingItem()
+	{
+		++instances;
+	}
+
+	ThrowingItem(const ThrowingItem&)
+	{
+		if(copiesLeft-- == 0)
+		{
+			throw std::runtime_error("Copy failed");
+		}
+
+		++instances;
+	}
+
+	ThrowingItem& operator=(const ThrowingItem&) = default;
+
+	~ThrowingItem()
+	{
+		--instances;
+	}
+};
+
+int ThrowingItem::instances = 0;
+int ThrowingItem::copiesLeft = 0;
+
+} // namespace
+
+static_assert(aisdi::StaticVector<int, 4>{}.empty(),
+	"Default constructed StaticVector shall be empty");
+static_assert(aisdi::StaticVector<int, 4>{1, 2, 3}.size() == 3,
+	"StaticVector shall be list-initializable in constant expressions");
+static_assert(aisdi::StaticVector<int, 4>{1, 2} == aisdi::StaticVector<int, 4>{1, 2},
+	"StaticVector shall be comparable in constant expressions");
+static_assert(sumOfAppended() == 3,
+	"StaticVector shall be modifiable in constant expressions");
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	WhenDefaultConstructing_ThenItIsEmpty,
+	T, TestTypes)
+{
+	const auto vector = TestVector<T>{};
+
+	BOOST_CHECK(vector.empty());
+	BOOST_CHECK(vector.capacity() == Capacity);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenInitializer_WhenListInitializing_ThenItHasSameItems,
+	T, TestTypes)
+{
+	auto il = {T{1}, T{2}, T{3}};
+	const auto vector = TestVector<T>{il};
+
+	BOOST_CHECK(vector.size() == il.size());
+	BOOST_CHECK(std::equal(il.begin(), il.end(), vector.begin()));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenTooLongInitializer_WhenListInitializing_ThenExceptionIsThrown,
+	T, TestTypes)
+{
+	using SmallVector = aisdi::StaticVector<T, 2>;
+
+	BOOST_CHECK_THROW((SmallVector{T{1}, T{2}, T{3}}), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenOtherContainer_WhenCopyConstructing_ThenTheyAreEqual,
+	T, TestTypes)
+{
+	const auto vector1 = TestVector<T>{1, 2, 3};
+	const auto vector2 = vector1;
+
+	BOOST_CHECK(vector1 == vector2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenOtherContainer_WhenMoveConstructing_ThenItHasHisContents,
+	T, TestTypes)
+{
+	auto vector1 = TestVector<T>{1, 2, 3};
+	const auto vector2 = std::move(vector1);
+
+	BOOST_CHECK(vector1.empty());
+	BOOST_CHECK((vector2 == TestVector<T>{1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenOtherContainer_WhenAssigning_ThenTheyAreSame,
+	T, TestTypes)
+{
+	const auto vector1 = TestVector<T>{1, 2, 3};
+	auto vector2 = TestVector<T>{4, 5};
+	vector2 = vector1;
+
+	BOOST_CHECK(vector2 == vector1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenVariousItemsContainers_WhenCompared_ThenTheyAreNotEqual,
+	T, TestTypes)
+{
+	const auto vector1 = TestVector<T>{1, 2, 3};
+	const auto vector2 = TestVector<T>{1, 2, 4};
+	const auto vector3 = TestVector<T>{1, 2};
+
+	BOOST_CHECK(vector1 != vector2);
+	BOOST_CHECK(vector1 != vector3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenAppending_ThenItemIsPlacedAtEnd,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3};
+
+	vector.append(T{4});
+
+	BOOST_CHECK(vector.size() == 4);
+	BOOST_CHECK(vector.back() == T{4});
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenPrepending_ThenItemIsPlacedAtBegin,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3};
+
+	vector.prepend(T{4});
+
+	BOOST_CHECK((vector == TestVector<T>{4, 1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenInsertingInMiddle_ThenItemIsInserted,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3, 4, 5};
+
+	const auto shift = 2;
+	const auto newPos = vector.insert(vector.begin() + shift, T{6});
+
+	BOOST_CHECK(newPos == (vector.begin() + shift));
+	BOOST_CHECK((vector == TestVector<T>{1, 2, 6, 3, 4, 5}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenInsertingOwnItem_ThenItIsCopiedBeforeShifting,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3};
+
+	vector.insert(vector.begin(), vector.back());
+
+	BOOST_CHECK((vector == TestVector<T>{3, 1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenFullContainer_WhenAppending_ThenExceptionIsThrown,
+	T, TestTypes)
+{
+	auto vector = aisdi::StaticVector<T, 2>{T{1}, T{2}};
+
+	BOOST_CHECK(vector.full());
+	BOOST_CHECK_THROW(vector.append(T{3}), std::logic_error);
+	BOOST_CHECK(vector.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenPoppingBack_ThenLastItemIsRemovedAndReturned,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3};
+
+	const auto item = vector.popBack();
+
+	BOOST_CHECK(item == T{3});
+	BOOST_CHECK((vector == TestVector<T>{1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenPoppingFront_ThenFirstItemIsRemovedAndReturned,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3};
+
+	const auto item = vector.popFront();
+
+	BOOST_CHECK(item == T{1});
+	BOOST_CHECK((vector == TestVector<T>{2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenEmptyContainer_WhenPoppingBack_ThenExceptionIsThrown,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{};
+
+	BOOST_CHECK_THROW(vector.popBack(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenErasingInMiddle_ThenItemsAreRemoved,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3, 4, 5};
+
+	const auto pos = vector.erase(vector.begin() + 1, vector.begin() + 3);
+
+	BOOST_CHECK(pos == (vector.begin() + 1));
+	BOOST_CHECK((vector == TestVector<T>{1, 4, 5}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenResizing_ThenSizeIsChanged,
+	T, TestTypes)
+{
+	auto vector = TestVector<T>{1, 2, 3};
+
+	vector.resize(5);
+	BOOST_CHECK((vector == TestVector<T>{1, 2, 3, 0, 0}));
+
+	vector.resize(1);
+	BOOST_CHECK((vector == TestVector<T>{1}));
+
+	BOOST_CHECK_THROW(vector.resize(Capacity + 1), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenNonTrivialItems_WhenModifying_ThenTheyAreConstructedInPlace)
+{
+	auto vector = aisdi::StaticVector<std::string, 4>{"b", "c"};
+
+	vector.prepend("a");
+	vector.append("d");
+	BOOST_CHECK((vector == aisdi::StaticVector<std::string, 4>{"a", "b", "c", "d"}));
+
+	vector.erase(vector.begin() + 1);
+	BOOST_CHECK((vector == aisdi::StaticVector<std::string, 4>{"a", "c", "d"}));
+
+	auto other = std::move(vector);
+	BOOST_CHECK(vector.empty());
+	BOOST_CHECK(other.popFront() == "a");
+	BOOST_CHECK(other.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(
+	GivenThrowingItems_WhenCopyingFails_ThenOnlyConstructedItemsAreDestroyed)
+{
+	using Vector = aisdi::StaticVector<ThrowingItem, 4>;
+	ThrowingItem::copiesLeft = 100;
+	{
+		auto vector = Vector{};
+		vector.resize(3);
+		BOOST_REQUIRE(ThrowingItem::instances == 3);
+
+		ThrowingItem::copiesLeft = 2;
+		BOOST_CHECK_THROW(Vector{vector}, std::runtime_error);
+		BOOST_CHECK(ThrowingItem::instances == 3);
+
+		auto other = Vector{};
+		ThrowingItem::copiesLeft = 1;
+		BOOST_CHECK_THROW(other = vector, std::runtime_error);
+		BOOST_CHECK(other.size() == 1);
+		BOOST_CHECK(ThrowingItem::instances == 4);
+
+		ThrowingItem::copiesLeft = 0;
+		BOOST_CHECK_THROW((Vector{ThrowingItem{}}), std::runtime_error);
+		BOOST_CHECK(ThrowingItem::instances == 4);
+	}
+
+	BOOST_CHECK(ThrowingItem::instances == 0);
+}
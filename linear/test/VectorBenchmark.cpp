@@ -2,6 +2,7 @@
 
 #include <cstdlib>
  
+#include <aisdi/AlignedStorage.hpp>
 #include <aisdi/Vector.hpp>
 
 constexpr auto Iterations = 100000;
@@ -91,3 +92,57 @@ BENCHMARK_F(ComparingBenchmark, EqualityTest, 1000, 1)
     const auto equals = (container == other);
     static_cast<void>(equals);
 }
+
+class SearchingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+    	for(auto i = 0; i < Iterations; ++i)
+    	{
+    		container.append(rand() % 10000);
+    	}
+    }
+
+	aisdi::Vector<int> container;
+};
+
+BENCHMARK_F(SearchingBenchmark, FindTest, 1000, 1)
+{
+    const auto pos = aisdi::find(container.begin(), container.end(), -1);
+    static_cast<void>(pos);
+}
+
+BENCHMARK_F(SearchingBenchmark, CountTest, 1000, 1)
+{
+    const auto count = aisdi::count(container.begin(), container.end(), 42);
+    static_cast<void>(count);
+}
+
+class AlignedSearchingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+    	for(auto i = 0; i < Iterations; ++i)
+    	{
+    		container.append(rand() % 10000);
+    	}
+    }
+
+	aisdi::Vector<int, aisdi::AlignedStorage<int, 64>> container;
+};
+
+BENCHMARK_F(AlignedSearchingBenchmark, FindTest, 1000, 1)
+{
+    const auto pos = aisdi::find(container.begin(), container.end(), -1);
+    static_cast<void>(pos);
+}
+
+BENCHMARK_F(AlignedSearchingBenchmark, CountTest, 1000, 1)
+{
+    const auto count = aisdi::count(container.begin(), container.end(), 42);
+    static_cast<void>(count);
+}
@@ -620,3 +620,78 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(
 	vector.clear();
 	BOOST_CHECK(vector == aisdi::Vector<T>{});
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenErasingUnorderedInMiddle_ThenLastItemTakesItsPlace,
+	T, TestTypes)
+{
+	auto vector = aisdi::Vector<T>{1, 2, 3, 4};
+
+	const auto pos = vector.erase_unordered(vector.begin() + 1);
+
+	BOOST_CHECK(pos == (vector.begin() + 1));
+	BOOST_CHECK((vector == aisdi::Vector<T>{1, 4, 3}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenErasingUnorderedLastItem_ThenItIsPoppedFromBack,
+	T, TestTypes)
+{
+	auto vector = aisdi::Vector<T>{1, 2, 3};
+
+	const auto pos = vector.erase_unordered(vector.begin() + 2);
+
+	BOOST_CHECK(pos == vector.end());
+	BOOST_CHECK((vector == aisdi::Vector<T>{1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenErasingIf_ThenMatchingItemsAreRemovedInOrder,
+	T, TestTypes)
+{
+	auto vector = aisdi::Vector<T>{1, 2, 3, 4, 5, 6};
+
+	const auto count = vector.erase_if([](const auto& item) { return (item % 2) == 0; });
+
+	BOOST_CHECK(count == 3);
+	BOOST_CHECK((vector == aisdi::Vector<T>{1, 3, 5}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenRemovingValueUnordered_ThenAllOccurrencesAreRemoved,
+	T, TestTypes)
+{
+	auto vector = aisdi::Vector<T>{2, 1, 2, 3, 2, 2};
+
+	const auto count = vector.remove_value_unordered(vector.front());
+
+	BOOST_CHECK(count == 4);
+	BOOST_CHECK(vector.size() == 2);
+	BOOST_CHECK(std::count(vector.begin(), vector.end(), T{1}) == 1);
+	BOOST_CHECK(std::count(vector.begin(), vector.end(), T{3}) == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainer_WhenReserving_ThenCapacityGrowsAndItemsAreKept,
+	T, TestTypes)
+{
+	auto vector = aisdi::Vector<T>{1, 2, 3};
+
+	vector.reserve(100);
+
+	BOOST_CHECK(vector.capacity() >= 100);
+	BOOST_CHECK((vector == aisdi::Vector<T>{1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+	GivenContainerWithSpareCapacity_WhenShrinkingToFit_ThenCapacityEqualsSize,
+	T, TestTypes)
+{
+	auto vector = aisdi::Vector<T>{1, 2, 3};
+	vector.reserve(100);
+
+	vector.shrink_to_fit();
+
+	BOOST_CHECK(vector.capacity() == vector.size());
+	BOOST_CHECK((vector == aisdi::Vector<T>{1, 2, 3}));
+}
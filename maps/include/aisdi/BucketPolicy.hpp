@@ -0,0 +1,134 @@
+#ifndef AISDI_BUCKETPOLICY_HPP
+#define AISDI_BUCKETPOLICY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <gsl/gsl_assert>
+
+namespace aisdi {
+
+// Bucket policies decide how many buckets HashMap has and which of them
+// holds a given hash. Each policy provides following interface:
+//  static size_type bucketCount(size_type requested) - smallest supported
+//      bucket count not less than requested
+//  void reset(size_type bucketCount) - called whenever table is resized
+//  size_type index(std::size_t hash) const - index of the bucket for hash
+
+// Any bucket count, index is the remainder of hash division.
+// Integer division is slow and identity hashes of consecutive integers
+// are spread evenly only because they are consecutive.
+class ModuloBucketPolicy
+{
+public:
+    using size_type = std::size_t;
+
+    static size_type bucketCount(size_type requested) noexcept
+    {
+        return std::max(requested, size_type{1});
+    }
+
+    void reset(size_type bucketCount) noexcept
+    {
+        bucketCount_ = bucketCount;
+    }
+
+    size_type index(std::size_t hash) const
+    {
+        Expects(bucketCount_ > 0);
+        return (hash % bucketCount_);
+    }
+
+private:
+    size_type bucketCount_ = 0;
+};
+
+namespace detail {
+
+// Finalizer of MurmurHash3, every bit of hash affects every bit of result
+inline std::uint64_t mix64(std::uint64_t hash) noexcept
+{
+    hash ^= (hash >> 33);
+    hash *= UINT64_C(0xFF51AFD7ED558CCD);
+    hash ^= (hash >> 33);
+    hash *= UINT64_C(0xC4CEB9FE1A85EC53);
+    hash ^= (hash >> 33);
+    return hash;
+}
+
+// Base of policies using power of two bucket counts
+class PowerOfTwoBucketPolicy
+{
+public:
+    using size_type = std::size_t;
+
+    static size_type bucketCount(size_type requested) noexcept
+    {
+        // At least two buckets, so shift never covers the whole word
+        auto bucketCount = size_type{2};
+        while(bucketCount < requested)
+        {
+            bucketCount *= 2;
+        }
+
+        return bucketCount;
+    }
+
+    void reset(size_type bucketCount) noexcept
+    {
+        Expects(bucketCount >= 2 && (bucketCount & (bucketCount - 1)) == 0);
+
+        auto bits = 0;
+        while((size_type{1} << bits) < bucketCount)
+        {
+            ++bits;
+        }
+
+        shift_ = std::numeric_limits<std::size_t>::digits - bits;
+        mask_ = bucketCount - 1;
+    }
+
+protected:
+    int shift_ = std::numeric_limits<std::size_t>::digits - 1;
+    std::size_t mask_ = 1;
+};
+
+} // namespace detail
+
+// Power of two bucket counts, index is taken from the top bits of hash
+// multiplied by 2^w / phi (Fibonacci hashing). No division is needed and
+// consecutive keys, which have consecutive identity hashes, land far apart.
+class FibonacciBucketPolicy
+    :   public detail::PowerOfTwoBucketPolicy
+{
+public:
+    size_type index(std::size_t hash) const noexcept
+    {
+        return ((hash * Multiplier) >> shift_);
+    }
+
+private:
+    constexpr static std::size_t Multiplier = (sizeof(std::size_t) == 8)
+        ? static_cast<std::size_t>(UINT64_C(0x9E3779B97F4A7C15))
+        : static_cast<std::size_t>(UINT32_C(0x9E3779B9));
+};
+
+// Power of two bucket counts, index is taken from the low bits of hash
+// passed through an avalanche mixer (finalizer of MurmurHash3), so every
+// bit of hash affects the index. Slightly slower than FibonacciBucketPolicy,
+// but it also repairs hashes, which differ only in their top bits.
+class AvalancheBucketPolicy
+    :   public detail::PowerOfTwoBucketPolicy
+{
+public:
+    size_type index(std::size_t hash) const noexcept
+    {
+        return static_cast<size_type>(detail::mix64(hash) & mask_);
+    }
+};
+
+} // namespace aisdi
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef AISDI_CONCURRENTHASHMAP_HPP
+#define AISDI_CONCURRENTHASHMAP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl_assert>
+
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/HashMap.hpp"
+
+namespace aisdi {
+
+// Hash map, which may be used by many threads at once.
+//
+// Items are split by hash between shards, each of them being an
+// aisdi::HashMap guarded by its own reader-writer lock. Threads working on
+// different shards never wait for each other, and readers of one shard
+// only wait for its writers. Iterators and references are not handed out,
+// since they would outlive the lock: values are copied out by find() or
+// accessed by visit() and for_each() while the lock is held.
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = ModuloBucketPolicy>
+class ConcurrentHashMap
+{
+public:
+    using map_type = HashMap<Key, T, Hash, KeyEqual, BucketPolicy>;
+    using key_type = typename map_type::key_type;
+    using mapped_type = typename map_type::mapped_type;
+    using value_type = typename map_type::value_type;
+    using size_type = typename map_type::size_type;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+private:
+    using Mutex = std::shared_timed_mutex;
+    using ReadLock = std::shared_lock<Mutex>;
+    using WriteLock = std::unique_lock<Mutex>;
+
+    constexpr static size_type DefaultShardCount = 64;
+    constexpr static size_type CacheLineSize = 64;
+
+    struct Shard
+    {
+        mutable Mutex mutex;
+        map_type map;
+
+        // Keeps lock of the next shard away from cache lines of this one
+        char padding[CacheLineSize];
+    };
+
+public:
+    // Shard count is rounded up to a power of two
+    explicit ConcurrentHashMap(size_type shardCount = DefaultShardCount)
+    {
+        Expects(shardCount > 0);
+
+        while((size_type{1} << shardBits_) < shardCount)
+        {
+            ++shardBits_;
+        }
+
+        shards_.reset(new Shard[shard_count()]);
+
+        Ensures(shard_count() >= shardCount);
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    // Copies value of the key, if it is present
+    bool find(const key_type& key, mapped_type& value) const
+    {
+        const auto& shard = shardOf(key);
+        ReadLock lock(shard.mutex);
+
+        const auto pos = shard.map.find(key);
+        if(pos == shard.map.end())
+        {
+            return false;
+        }
+
+        value = pos->second;
+        return true;
+    }
+
+    bool contains(const key_type& key) const
+    {
+        const auto& shard = shardOf(key);
+        ReadLock lock(shard.mutex);
+
+        return shard.map.contains(key);
+    }
+
+    // Returns true, if the key was inserted, false, if it was assigned
+    template<typename M>
+    bool insert_or_assign(const key_type& key, M&& obj)
+    {
+        auto& shard = shardOf(key);
+        WriteLock lock(shard.mutex);
+
+        const auto size = shard.map.size();
+        shard.map.insert_or_assign(key, std::forward<M>(obj));
+        return (shard.map.size() > size);
+    }
+
+    size_type erase(const key_type& key)
+    {
+        auto& shard = shardOf(key);
+        WriteLock lock(shard.mutex);
+
+        return shard.map.erase(key);
+    }
+
+    // Calls fn(mapped_type&) with value of the key, while its shard is
+    // locked for writing. Returns false, if the key is missing.
+    // NOTE: fn must not access this map.
+    template<typename UnaryFunction>
+    bool visit(const key_type& key, UnaryFunction fn)
+    {
+        auto& shard = shardOf(key);
+        WriteLock lock(shard.mutex);
+
+        const auto pos = shard.map.find(key);
+        if(pos == shard.map.end())
+        {
+            return false;
+        }
+
+        fn(pos->second);
+        return true;
+    }
+
+    // Calls fn(const mapped_type&), while shard of the key is locked for reading
+    template<typename UnaryFunction>
+    bool visit(const key_type& key, UnaryFunction fn) const
+    {
+        const auto& shard = shardOf(key);
+        ReadLock lock(shard.mutex);
+
+        const auto pos = shard.map.find(key);
+        if(pos == shard.map.end())
+        {
+            return false;
+        }
+
+        fn(pos->second);
+        return true;
+    }
+
+    // Calls fn(const value_type&) for every item. Shards are visited in
+    // parallel by up to threadCount threads (including the calling one),
+    // each shard being locked for reading, so fn has to be thread-safe.
+    // First exception thrown by fn is rethrown, once all threads finish.
+    template<typename UnaryFunction>
+    void for_each(UnaryFunction fn,
+                  size_type threadCount = std::thread::hardware_concurrency()) const
+    {
+        threadCount = std::max(size_type{1}, std::min(threadCount, shard_count()));
+
+        std::atomic<size_type> nextShard{0};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        const auto work = [this, &fn, &nextShard, &error, &errorMutex]
+            {
+                try
+                {
+                    for(auto index = nextShard++; index < shard_count(); index = nextShard++)
+                    {
+                        const auto& shard = shards_[index];
+                        ReadLock lock(shard.mutex);
+                        std::for_each(shard.map.begin(), shard.map.end(), fn);
+                    }
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if(!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            };
+
+        auto threads = std::vector<std::thread>{};
+        for(auto i = size_type{1}; i < threadCount; ++i)
+        {
+            threads.emplace_back(work);
+        }
+
+        work();
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void clear()
+    {
+        for(auto index = size_type{0}; index < shard_count(); ++index)
+        {
+            auto& shard = shards_[index];
+            WriteLock lock(shard.mutex);
+            shard.map = map_type{};
+        }
+    }
+
+    // NOTE: Shards are counted one after another, so with concurrent
+    //  writers result may not match any single moment.
+    size_type size() const
+    {
+        auto result = size_type{0};
+        for(auto index = size_type{0}; index < shard_count(); ++index)
+        {
+            const auto& shard = shards_[index];
+            ReadLock lock(shard.mutex);
+            result += shard.map.size();
+        }
+
+        return result;
+    }
+
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    size_type shard_count() const noexcept
+    {
+        return (size_type{1} << shardBits_);
+    }
+
+private:
+    // Shards are chosen by top bits of mixed hash, while buckets of shard
+    // maps by the hash itself (or by its low mixed bits), so keys of
+    // one shard are still spread over all its buckets
+    size_type shardIndex(std::size_t hash) const noexcept
+    {
+        if(shardBits_ == 0)
+        {
+            return 0;
+        }
+
+        const auto mixed = detail::mix64(hash);
+        return static_cast<size_type>(mixed >> (std::numeric_limits<std::uint64_t>::digits - shardBits_));
+    }
+
+    Shard& shardOf(const key_type& key)
+    {
+        return shards_[shardIndex(hasher_(key))];
+    }
+
+    const Shard& shardOf(const key_type& key) const
+    {
+        return shards_[shardIndex(hasher_(key))];
+    }
+
+    std::unique_ptr<Shard[]> shards_;
+    int shardBits_ = 0;
+    hasher hasher_;
+};
+
+} // namespace aisdi
+
+#endif
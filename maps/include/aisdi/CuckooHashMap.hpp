@@ -0,0 +1,1157 @@
+#ifndef AISDI_CUCKOOHASHMAP_HPP
+#define AISDI_CUCKOOHASHMAP_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <gsl/gsl_assert>
+
+#include "aisdi/AlignedStorage.hpp"
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/Transparent.hpp"
+#include "aisdi/util.hpp"
+
+namespace aisdi {
+
+// Bucketized cuckoo hash map with the interface of HashMap.
+//
+// A key may be kept only in one of its two buckets, chosen by two hash
+// functions derived from a single call of Hash. Each bucket has four slots
+// and a one byte tag of every slot, which rules out most keys without
+// comparing them. Buckets are aligned to cache lines, so when four items
+// fit in one line with their tags (e.g. int keys and values), a lookup
+// reads at most two cache lines, however many keys collide, as long as
+// the stash (see below) is empty. While any item waits there, every lookup
+// missing in both buckets reads the stash as a third line.
+//
+// Inserting into two full buckets looks for a bounded path of moves freeing
+// a slot: an item of a full bucket goes to its other bucket, which may move
+// one of its items further, and so on. An item, for which no path is found,
+// waits in a small stash searched after both buckets. Table doubles when
+// the stash is full or max_load_factor() would be exceeded. Keys with equal
+// hashes cannot be separated this way, so inserting more of them than two
+// buckets and the stash may hold throws std::length_error (a seeded hasher
+// from Hash.hpp keeps attackers from picking such keys).
+//
+// NOTE: Unlike in HashMap, insertion may move other items to their other
+//  buckets, so it invalidates iterators and references. Erasing does not
+//  move anything. begin() looks for the first occupied slot.
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class CuckooHashMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    class ConstIterator;
+    class Iterator;
+
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+private:
+    template<typename K, typename V, typename H, typename E>
+    friend bool operator==(const CuckooHashMap<K, V, H, E>& lhs,
+                           const CuckooHashMap<K, V, H, E>& rhs);
+
+    // Tags of a bucket are compared as one 32-bit word
+    constexpr static size_type Ways = 4;
+    constexpr static size_type CacheLineSize = 64;
+    constexpr static size_type DefaultBucketCount = 4;
+    constexpr static float DefaultMaxLoadFactor = 0.9f;
+    constexpr static size_type MaxPathLength = 64;
+    constexpr static size_type SparseTableDivisor = 16;
+    constexpr static size_type FindBatchSize = 16;
+    constexpr static std::uint8_t FreeTag = 0;
+
+    using Slot = std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+
+    // Tags come first, so for small items the whole bucket is one line
+    struct alignas(CacheLineSize) Bucket
+    {
+        std::uint8_t tags[Ways] = {};
+        Slot slots[Ways];
+    };
+
+    // Bucket at index bucketCount_ is the stash
+    using Buckets = AlignedStorage<Bucket, CacheLineSize>;
+
+    // Items are moved to a new table by rehash(), when they can be moved
+    // back without throwing, and copied otherwise
+    constexpr static bool IsRehashMoving = std::is_nothrow_move_constructible<value_type>::value;
+    using RehashedItem = std::conditional_t<IsRehashMoving
+                                                || !std::is_copy_constructible<value_type>::value,
+                                            value_type&&, const value_type&>;
+
+    // Both buckets, which may hold a key, and tag of its slot
+    struct Place
+    {
+        size_type first;
+        size_type second;
+        std::uint8_t tag;
+    };
+
+    // Lookups by any K are enabled, when both Hash and KeyEqual are
+    // transparent. Iterators are excluded, so erase(pos) is not hijacked.
+    template<typename K, typename H = Hash, typename E = KeyEqual>
+    using EnableIfTransparent =
+        std::enable_if_t<detail::IsTransparent<H>::value
+                         && detail::IsTransparent<E>::value
+                         && !std::is_convertible<K, const_iterator>::value>;
+
+public:
+    explicit CuckooHashMap(size_type bucketCount = DefaultBucketCount)
+    {
+        init(bucketCount);
+    }
+
+    // Uses given function objects, e.g. a hasher with a chosen seed
+    CuckooHashMap(size_type bucketCount,
+                  const hasher& hash,
+                  const key_equal& equal = key_equal())
+        :   keyEqual_(equal)
+        ,   hasher_(hash)
+    {
+        init(bucketCount);
+    }
+
+    template<typename InputIt>
+    CuckooHashMap(InputIt first, InputIt last,
+                  size_type bucketCount = DefaultBucketCount)
+        :   CuckooHashMap(bucketCount)
+    {
+        std::for_each(first, last,
+                      [this](const auto& value)
+                      {
+                          const auto& key = value.first;
+                          const auto& mapped = value.second;
+                          this->operator[](key) = mapped;
+                      });
+    }
+
+    CuckooHashMap(std::initializer_list<value_type> init,
+                  size_type bucketCount = DefaultBucketCount)
+        :   CuckooHashMap(init.begin(), init.end(), bucketCount)
+    {}
+
+    // Items keep their slots, since both maps hash keys the same way
+    CuckooHashMap(const CuckooHashMap& other)
+        :   maxLoadFactor_(other.maxLoadFactor_)
+        ,   keyEqual_(other.keyEqual_)
+        ,   hasher_(other.hasher_)
+    {
+        if(other.bucketCount_ == 0)
+        {
+            return;
+        }
+
+        init(other.bucketCount_);
+        try
+        {
+            for(auto slot = other.nextSlot(0); slot != other.endSlot(); slot = other.nextSlot(slot + 1))
+            {
+                construct(slot, other.tagAt(slot), other.itemAt(slot));
+            }
+        }
+        catch(...)
+        {
+            destroyItems();
+            throw;
+        }
+
+        Ensures(size_ == other.size_);
+        Ensures(stashed_ == other.stashed_);
+    }
+
+    CuckooHashMap(CuckooHashMap&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    ~CuckooHashMap()
+    {
+        destroyItems();
+    }
+
+    CuckooHashMap& operator=(const CuckooHashMap& other)
+    {
+        if(&other != this)
+        {
+            auto copy = other;
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    // Moved from map has no buckets, until an item is inserted into it
+    CuckooHashMap& operator=(CuckooHashMap&& other) noexcept
+    {
+        if(&other != this)
+        {
+            destroyItems();
+
+            buckets_ = std::move(other.buckets_);
+            bucketCount_ = other.bucketCount_;
+            size_ = other.size_;
+            stashed_ = other.stashed_;
+            maxLoadFactor_ = other.maxLoadFactor_;
+            keyEqual_ = std::move(other.keyEqual_);
+            hasher_ = std::move(other.hasher_);
+
+            other.bucketCount_ = 0;
+            other.size_ = 0;
+            other.stashed_ = 0;
+        }
+
+        return *this;
+    }
+
+    iterator begin()
+    {
+        return iterator{this, nextSlot(0)};
+    }
+
+    const_iterator begin() const
+    {
+        return const_cast<CuckooHashMap&>(*this).begin();
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    iterator end()
+    {
+        return iterator{this, endSlot()};
+    }
+
+    const_iterator end() const
+    {
+        return const_cast<CuckooHashMap&>(*this).end();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    // Returns position of the item with key of value and whether it was
+    // inserted, so a key is both checked and added with a single lookup
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return emplaceKey(value.first, value);
+    }
+
+    T& operator[](const key_type& key)
+    {
+        const auto result = emplaceKey(key,
+                                       std::piecewise_construct,
+                                       std::forward_as_tuple(key),
+                                       std::forward_as_tuple());
+        const auto pos = result.first;
+        auto& mapped = pos->second;
+        return mapped;
+    }
+
+    template<class M>
+    iterator insert_or_assign(const key_type& key, M&& obj)
+    {
+        const auto result = emplaceKey(key,
+                                       std::piecewise_construct,
+                                       std::forward_as_tuple(key),
+                                       std::forward_as_tuple(std::forward<M>(obj)));
+        const auto pos = result.first;
+        if(!result.second)
+        {
+            pos->second = std::forward<M>(obj);
+        }
+
+        return pos;
+    }
+
+    T& at(const key_type& key)
+    {
+        return mappedAt(key);
+    }
+
+    const T& at(const key_type& key) const
+    {
+        return const_cast<CuckooHashMap&>(*this).mappedAt(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    T& at(const K& key)
+    {
+        return mappedAt(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    const T& at(const K& key) const
+    {
+        return const_cast<CuckooHashMap&>(*this).mappedAt(key);
+    }
+
+    // Frees the slot without moving other items, so only iterators
+    // to the erased item are invalidated
+    iterator erase(const const_iterator& pos)
+    {
+        Expects(pos != end());
+
+        const auto slot = pos.slot_;
+        destroy(slot);
+        return iterator{this, nextSlot(slot + 1)};
+    }
+
+    size_type erase(const key_type& key)
+    {
+        return eraseKey(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    size_type erase(const K& key)
+    {
+        return eraseKey(key);
+    }
+
+    bool contains(const key_type& key) const
+    {
+        return (find(key) != end());
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    bool contains(const K& key) const
+    {
+        return (find(key) != end());
+    }
+
+    size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    size_type count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    iterator find(const key_type& key)
+    {
+        return iterator{this, locate(key)};
+    }
+
+    const_iterator find(const key_type& key) const
+    {
+        return const_cast<CuckooHashMap&>(*this).find(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    iterator find(const K& key)
+    {
+        return iterator{this, locate(key)};
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    const_iterator find(const K& key) const
+    {
+        return const_cast<CuckooHashMap&>(*this).find(key);
+    }
+
+    // Looks up every key in [keysFirst, keysLast) and writes its iterator
+    // (or end(), if key is missing) to out. Keys are processed in batches:
+    // all hashes are computed first and both buckets of every key are
+    // prefetched, so cache misses of different keys overlap.
+    template<typename ForwardIt, typename OutputIt>
+    OutputIt find_many(ForwardIt keysFirst, ForwardIt keysLast, OutputIt out)
+    {
+        return findMany<iterator>(keysFirst, keysLast, out);
+    }
+
+    template<typename ForwardIt, typename OutputIt>
+    OutputIt find_many(ForwardIt keysFirst, ForwardIt keysLast, OutputIt out) const
+    {
+        return const_cast<CuckooHashMap&>(*this)
+            .template findMany<const_iterator>(keysFirst, keysLast, out);
+    }
+
+    // Returns the first of two buckets, which may hold the key
+    size_type bucket(const Key& key) const
+    {
+        Expects(bucket_count() > 0);
+        return placeOf(hashOf(key)).first;
+    }
+
+    // Fraction of occupied slots, four in each bucket
+    float load_factor() const
+    {
+        Expects(bucket_count() > 0);
+        const auto slotCount = static_cast<float>(bucket_count() * Ways);
+        return (static_cast<float>(size()) / slotCount);
+    }
+
+    float max_load_factor() const noexcept
+    {
+        return maxLoadFactor_;
+    }
+
+    void max_load_factor(float maxLoadFactor)
+    {
+        Expects(maxLoadFactor > 0.0f && maxLoadFactor <= 1.0f);
+        maxLoadFactor_ = maxLoadFactor;
+    }
+
+    // Moves items into at least bucketCount buckets (and at least as many
+    // as max_load_factor() requires). Bucket count is a power of two, and
+    // it is doubled further, if some items would not fit. Invalidates iterators.
+    void rehash(size_type bucketCount)
+    {
+        const auto minBucketCount = static_cast<size_type>(
+            std::ceil(static_cast<float>(size_) / (maxLoadFactor_ * Ways)));
+        bucketCount = detail::PowerOfTwoBucketPolicy::bucketCount(
+            std::max(bucketCount, minBucketCount));
+        if(bucketCount == bucket_count())
+        {
+            return;
+        }
+
+        while(!rehashInto(bucketCount))
+        {
+            bucketCount *= 2;
+        }
+
+        Ensures(bucket_count() == bucketCount);
+    }
+
+    // Prepares map for count items without exceeding max_load_factor()
+    void reserve(size_type count)
+    {
+        rehash(static_cast<size_type>(
+            std::ceil(static_cast<float>(count) / (maxLoadFactor_ * Ways))));
+    }
+
+    size_type bucket_count() const noexcept
+    {
+        return bucketCount_;
+    }
+
+    size_type bucket_size(size_type bucketIndex) const
+    {
+        Expects(bucketIndex < bucket_count());
+        const auto& tags = buckets_.data()[bucketIndex].tags;
+        return static_cast<size_type>(std::count_if(std::begin(tags), std::end(tags),
+                                                    [](auto tag)
+                                                    {
+                                                        return (tag != FreeTag);
+                                                    }));
+    }
+
+    bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    hasher hash_function() const
+    {
+        return hasher_;
+    }
+
+    key_equal key_eq() const
+    {
+        return keyEqual_;
+    }
+
+private:
+    // Places all items in a new table of bucketCount buckets and replaces
+    // the map with it, or returns false, when some item finds no room there.
+    // Hash may throw after some items were placed, so the map is replaced
+    // only at the end. Moved items are then moved back to slots recorded
+    // for them, so a failed rehash leaves the map intact, unless items
+    // can be neither copied nor moved without throwing.
+    bool rehashInto(size_type bucketCount)
+    {
+        auto table = CuckooHashMap(bucketCount, hasher_, keyEqual_);
+        table.maxLoadFactor_ = maxLoadFactor_;
+        // Slot of this map, from which each slot of table got its item
+        auto origins = std::unique_ptr<size_type[]>{};
+        if(IsRehashMoving)
+        {
+            origins = std::make_unique<size_type[]>(table.endSlot());
+        }
+
+        try
+        {
+            for(auto slot = nextSlot(0); slot != endSlot(); slot = nextSlot(slot + 1))
+            {
+                auto& item = itemAt(slot);
+                const auto target = table.tryPlaceItem(table.hashOf(item.first), origins.get(),
+                                                       static_cast<RehashedItem>(item));
+                if(target == table.endSlot())
+                {
+                    if(table.isSparse())
+                    {
+                        throw std::length_error("Too many keys with colliding hashes");
+                    }
+
+                    restoreItems(table, origins.get());
+                    return false;
+                }
+
+                if(origins)
+                {
+                    origins[target] = slot;
+                }
+            }
+        }
+        catch(...)
+        {
+            restoreItems(table, origins.get());
+            throw;
+        }
+
+        *this = std::move(table);
+        return true;
+    }
+
+    // Moves items of table back to their slots of origin in this map,
+    // which still hold moved from items (see rehashInto())
+    void restoreItems(CuckooHashMap& table, const size_type* origins) noexcept
+    {
+        if(!origins)
+        {
+            return;
+        }
+
+        for(auto slot = table.nextSlot(0); slot != table.endSlot(); slot = table.nextSlot(slot + 1))
+        {
+            auto& item = itemAt(origins[slot]);
+            util::destroy_at(&item);
+            new (static_cast<void*>(&item)) value_type(std::move(table.itemAt(slot)));
+        }
+    }
+
+    void init(size_type bucketCount)
+    {
+        bucketCount_ = detail::PowerOfTwoBucketPolicy::bucketCount(bucketCount);
+        buckets_ = Buckets(bucketCount_ + 1);
+        size_ = 0;
+        stashed_ = 0;
+
+        Ensures(empty());
+    }
+
+    template<typename K>
+    std::uint64_t hashOf(const K& key) const
+    {
+        return detail::mix64(static_cast<std::uint64_t>(hasher_(key)));
+    }
+
+    // Buckets are taken from low and high half of the mixed hash, the tag
+    // from bits between them, so it tells apart keys sharing a bucket
+    Place placeOf(std::uint64_t hash) const noexcept
+    {
+        const auto mask = bucketCount_ - 1;
+        const auto first = static_cast<size_type>(hash) & mask;
+        auto second = static_cast<size_type>(hash >> 32) & mask;
+        if(second == first)
+        {
+            second ^= 1;
+        }
+
+        const auto tag = static_cast<std::uint8_t>(hash >> 24);
+        return {first, second, (tag != FreeTag) ? tag : std::uint8_t{1}};
+    }
+
+    size_type endSlot() const noexcept
+    {
+        return (bucketCount_ > 0) ? (bucketCount_ + 1) * Ways : 0;
+    }
+
+    size_type stashBucket() const noexcept
+    {
+        return bucketCount_;
+    }
+
+    std::uint8_t& tagAt(size_type slot) noexcept
+    {
+        return buckets_.data()[slot / Ways].tags[slot % Ways];
+    }
+
+    std::uint8_t tagAt(size_type slot) const noexcept
+    {
+        return buckets_.data()[slot / Ways].tags[slot % Ways];
+    }
+
+    value_type& itemAt(size_type slot) noexcept
+    {
+        auto& storage = buckets_.data()[slot / Ways].slots[slot % Ways];
+        return *reinterpret_cast<value_type*>(&storage);
+    }
+
+    const value_type& itemAt(size_type slot) const noexcept
+    {
+        return const_cast<CuckooHashMap&>(*this).itemAt(slot);
+    }
+
+    // Returns the first occupied slot not before slot, or endSlot()
+    size_type nextSlot(size_type slot) const noexcept
+    {
+        while(slot < endSlot() && tagAt(slot) == FreeTag)
+        {
+            ++slot;
+        }
+
+        return slot;
+    }
+
+    // Returns the last occupied slot before slot
+    size_type previousSlot(size_type slot) const noexcept
+    {
+        do
+        {
+            --slot;
+        }
+        while(tagAt(slot) == FreeTag);
+
+        return slot;
+    }
+
+    size_type freeSlotIn(size_type bucketIndex) const noexcept
+    {
+        const auto& tags = buckets_.data()[bucketIndex].tags;
+        for(auto way = size_type{0}; way < Ways; ++way)
+        {
+            if(tags[way] == FreeTag)
+            {
+                return bucketIndex * Ways + way;
+            }
+        }
+
+        return endSlot();
+    }
+
+    // Returns one bit for every way of the bucket, which has the tag.
+    // All tags are compared at once, as bytes of a single word, so lookups
+    // do not branch on the (random) way holding the key.
+    static unsigned matchingWays(const Bucket& bucket, std::uint8_t tag) noexcept
+    {
+        const auto tags = static_cast<std::uint32_t>(bucket.tags[0])
+            | static_cast<std::uint32_t>(bucket.tags[1]) << 8
+            | static_cast<std::uint32_t>(bucket.tags[2]) << 16
+            | static_cast<std::uint32_t>(bucket.tags[3]) << 24;
+        // Bytes of equal tags are all ones. Adding one to their low seven
+        // bits carries into the top bit, which is kept only for such bytes.
+        const auto equal = ~(tags ^ (UINT32_C(0x01010101) * tag));
+        const auto low = equal & UINT32_C(0x7F7F7F7F);
+        const auto high = ((low + UINT32_C(0x01010101)) & equal) & UINT32_C(0x80808080);
+        return static_cast<unsigned>(((high >> 7) | (high >> 14) | (high >> 21) | (high >> 28)) & 0xFu);
+    }
+
+    // Returns slot of the key in the bucket, or endSlot()
+    template<typename K>
+    size_type findIn(size_type bucketIndex, std::uint8_t tag, const K& key) const
+    {
+        constexpr static std::uint8_t LowestWay[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+
+        const auto& bucket = buckets_.data()[bucketIndex];
+        for(auto ways = matchingWays(bucket, tag); ways != 0; ways &= ways - 1)
+        {
+            const auto slot = bucketIndex * Ways + LowestWay[ways];
+            if(keyEqual_(key, itemAt(slot).first))
+            {
+                return slot;
+            }
+        }
+
+        return endSlot();
+    }
+
+    // Returns slot of the key, or endSlot(), if key is missing.
+    // K is key_type, unless Hash and KeyEqual are transparent.
+    template<typename K>
+    size_type locate(const K& key) const
+    {
+        if(empty())
+        {
+            return endSlot();
+        }
+
+        const auto place = placeOf(hashOf(key));
+        util::prefetch(buckets_.data() + place.second);
+        return locateAt(place, key);
+    }
+
+    template<typename K>
+    size_type locateAt(const Place& place, const K& key) const
+    {
+        auto slot = findIn(place.first, place.tag, key);
+        if(slot == endSlot())
+        {
+            slot = findIn(place.second, place.tag, key);
+        }
+
+        if(slot == endSlot() && stashed_ > 0)
+        {
+            slot = findIn(stashBucket(), place.tag, key);
+        }
+
+        return slot;
+    }
+
+    // Returns position of the key, or of a new item constructed of args,
+    // if key is missing. Args are not used, when key is present.
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplaceKey(const K& key, Args&&... args)
+    {
+        const auto slot = locate(key);
+        if(slot != endSlot())
+        {
+            return {iterator{this, slot}, false};
+        }
+
+        const auto maxSize = static_cast<float>(bucket_count() * Ways) * maxLoadFactor_;
+        if(static_cast<float>(size_ + 1) > maxSize)
+        {
+            grow();
+        }
+
+        const auto newSlot = placeItem(hashOf(key), std::forward<Args>(args)...);
+        return {iterator{this, newSlot}, true};
+    }
+
+    // Constructs a new item of args in one of buckets of the hash, making
+    // room for it or growing the table, if needed, and returns its slot
+    template<typename... Args>
+    size_type placeItem(std::uint64_t hash, Args&&... args)
+    {
+        while(true)
+        {
+            const auto slot = tryPlaceItem(hash, nullptr, std::forward<Args>(args)...);
+            if(slot != endSlot())
+            {
+                return slot;
+            }
+
+            if(isSparse())
+            {
+                throw std::length_error("Too many keys with colliding hashes");
+            }
+
+            grow();
+        }
+    }
+
+    // Same as placeItem(), but returns endSlot() instead of growing the
+    // table. Unless origins are null, they follow items moved on the way.
+    template<typename... Args>
+    size_type tryPlaceItem(std::uint64_t hash, size_type* origins, Args&&... args)
+    {
+        const auto place = placeOf(hash);
+        auto slot = freeSlotIn(place.first);
+        if(slot == endSlot())
+        {
+            slot = freeSlotIn(place.second);
+        }
+
+        if(slot == endSlot())
+        {
+            slot = makeRoom(place, origins);
+        }
+
+        if(slot == endSlot())
+        {
+            slot = freeSlotIn(stashBucket());
+        }
+
+        if(slot != endSlot())
+        {
+            construct(slot, place.tag, std::forward<Args>(args)...);
+        }
+
+        return slot;
+    }
+
+    // Growing does not separate keys with equal hashes, so it is given up,
+    // when even a mostly empty table cannot take a key
+    bool isSparse() const noexcept
+    {
+        return (size_ < bucket_count() * Ways / SparseTableDivisor);
+    }
+
+    // Looks for a path of slots starting in a bucket of place, in which
+    // every item may move to the bucket of the next slot and the last one
+    // to a free slot. Items are then moved from the end of the path, so each
+    // move has a free target and a failed move loses no item. Returns the
+    // slot freed at the start of the path, or endSlot().
+    size_type makeRoom(const Place& place, size_type* origins)
+    {
+        size_type path[MaxPathLength];
+        auto bucketIndex = (++kicks_ % 2 == 0) ? place.first : place.second;
+        for(auto length = size_type{0}; length < MaxPathLength; ++length)
+        {
+            const auto slot = pickVictim(bucketIndex, path, length);
+            if(slot == endSlot())
+            {
+                break;
+            }
+
+            path[length] = slot;
+            const auto otherBucket = otherBucketOf(slot);
+            auto target = freeSlotIn(otherBucket);
+            if(target != endSlot())
+            {
+                for(auto i = length + 1; i-- > 0;)
+                {
+                    relocate(path[i], target, origins);
+                    target = path[i];
+                }
+
+                return target;
+            }
+
+            bucketIndex = otherBucket;
+        }
+
+        return endSlot();
+    }
+
+    // Picks a slot of the bucket, which is not on the path yet. Ways are
+    // tried from a rotating one, so repeated searches take different paths.
+    size_type pickVictim(size_type bucketIndex, const size_type* path, size_type length)
+    {
+        const auto firstWay = ++kicks_;
+        for(auto i = size_type{0}; i < Ways; ++i)
+        {
+            const auto slot = bucketIndex * Ways + (firstWay + i) % Ways;
+            if(std::find(path, path + length, slot) == path + length)
+            {
+                return slot;
+            }
+        }
+
+        return endSlot();
+    }
+
+    size_type otherBucketOf(size_type slot) const
+    {
+        const auto place = placeOf(hashOf(itemAt(slot).first));
+        return (slot / Ways == place.first) ? place.second : place.first;
+    }
+
+    template<typename... Args>
+    void construct(size_type slot, std::uint8_t tag, Args&&... args)
+    {
+        Expects(tagAt(slot) == FreeTag);
+
+        auto& storage = buckets_.data()[slot / Ways].slots[slot % Ways];
+        new (&storage) value_type(std::forward<Args>(args)...);
+        tagAt(slot) = tag;
+        ++size_;
+        if(slot / Ways == stashBucket())
+        {
+            ++stashed_;
+        }
+    }
+
+    void destroy(size_type slot) noexcept
+    {
+        util::destroy_at(&itemAt(slot));
+        tagAt(slot) = FreeTag;
+        --size_;
+        if(slot / Ways == stashBucket())
+        {
+            --stashed_;
+        }
+    }
+
+    // Item is constructed in target before it is destroyed in source,
+    // so an exception leaves it in source
+    void relocate(size_type source, size_type target, size_type* origins)
+    {
+        construct(target, tagAt(source), std::move_if_noexcept(itemAt(source)));
+        destroy(source);
+        if(origins)
+        {
+            origins[target] = origins[source];
+        }
+    }
+
+    void grow()
+    {
+        rehash(std::max(bucket_count() * 2, DefaultBucketCount));
+    }
+
+    void destroyItems() noexcept
+    {
+        for(auto slot = nextSlot(0); slot != endSlot(); slot = nextSlot(slot + 1))
+        {
+            destroy(slot);
+        }
+
+        Ensures(size_ == 0);
+        Ensures(stashed_ == 0);
+    }
+
+    template<typename K>
+    size_type eraseKey(const K& key)
+    {
+        const auto slot = locate(key);
+        if(slot == endSlot())
+        {
+            return 0;
+        }
+
+        destroy(slot);
+        return 1;
+    }
+
+    template<typename K>
+    T& mappedAt(const K& key)
+    {
+        const auto slot = locate(key);
+        if(slot == endSlot())
+        {
+            throw std::out_of_range("Key not exist");
+        }
+
+        return itemAt(slot).second;
+    }
+
+    // Writes Result (iterator or const_iterator) of every key to out
+    template<typename Result, typename ForwardIt, typename OutputIt>
+    OutputIt findMany(ForwardIt keysFirst, ForwardIt keysLast, OutputIt out)
+    {
+        ForwardIt keys[FindBatchSize];
+        Place places[FindBatchSize];
+
+        while(keysFirst != keysLast)
+        {
+            auto count = size_type{0};
+            for(; count < FindBatchSize && keysFirst != keysLast; ++count, ++keysFirst)
+            {
+                keys[count] = keysFirst;
+                if(!empty())
+                {
+                    places[count] = placeOf(hashOf(*keysFirst));
+                    util::prefetch(buckets_.data() + places[count].first);
+                    util::prefetch(buckets_.data() + places[count].second);
+                }
+            }
+
+            for(auto i = size_type{0}; i < count; ++i)
+            {
+                const auto slot = empty() ? endSlot() : locateAt(places[i], *keys[i]);
+                *out++ = Result{this, slot};
+            }
+        }
+
+        return out;
+    }
+
+    Buckets buckets_;
+    size_type bucketCount_ = 0;
+    size_type size_ = 0;
+    size_type stashed_ = 0;
+    size_type kicks_ = 0;
+    float maxLoadFactor_ = DefaultMaxLoadFactor;
+    key_equal keyEqual_;
+    hasher hasher_;
+};
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr std::size_t CuckooHashMap<Key, T, Hash, KeyEqual>::Ways;
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr std::size_t CuckooHashMap<Key, T, Hash, KeyEqual>::DefaultBucketCount;
+
+// NOTE: Slots of equal keys depend on history of the maps,
+//  so items are looked up in the other map instead. O(size) expected.
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool operator==(const CuckooHashMap<Key, T, Hash, KeyEqual>& lhs,
+                const CuckooHashMap<Key, T, Hash, KeyEqual>& rhs)
+{
+    if(&lhs == &rhs)
+    {
+        return true;
+    }
+
+    if(lhs.size() != rhs.size())
+    {
+        return false;
+    }
+
+    return std::all_of(lhs.begin(), lhs.end(),
+                       [&rhs](const auto& item)
+                       {
+                           const auto pos = rhs.find(item.first);
+                           return (pos != rhs.end()) && (pos->second == item.second);
+                       });
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool operator!=(const CuckooHashMap<Key, T, Hash, KeyEqual>& lhs,
+                const CuckooHashMap<Key, T, Hash, KeyEqual>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+class CuckooHashMap<Key, T, Hash, KeyEqual>::ConstIterator
+{
+    friend class CuckooHashMap;
+
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename CuckooHashMap::value_type;
+    using difference_type = typename CuckooHashMap::difference_type;
+    using pointer = typename CuckooHashMap::const_pointer;
+    using reference = typename CuckooHashMap::const_reference;
+
+    ConstIterator() = default;
+
+    ConstIterator(CuckooHashMap* map, size_type slot)
+        :   map_(map)
+        ,   slot_(slot)
+    {}
+
+    reference operator*() const
+    {
+        Expects(map_ && slot_ < map_->endSlot());
+        return map_->itemAt(slot_);
+    }
+
+    pointer operator->() const
+    {
+        return std::addressof(operator*());
+    }
+
+    ConstIterator& operator--()
+    {
+        Expects(map_ && slot_ != map_->nextSlot(0));
+        slot_ = map_->previousSlot(slot_);
+        return *this;
+    }
+
+    ConstIterator operator--(int)
+    {
+        const auto result = *this;
+        operator--();
+        return result;
+    }
+
+    ConstIterator& operator++()
+    {
+        Expects(map_ && slot_ < map_->endSlot());
+        slot_ = map_->nextSlot(slot_ + 1);
+        return *this;
+    }
+
+    ConstIterator operator++(int)
+    {
+        const auto result = *this;
+        operator++();
+        return result;
+    }
+
+    bool operator==(const ConstIterator& rhs) const
+    {
+        return (map_ == rhs.map_ && slot_ == rhs.slot_);
+    }
+
+    bool operator!=(const ConstIterator& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    CuckooHashMap* map_ = nullptr;
+    size_type slot_ = 0;
+};
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+class CuckooHashMap<Key, T, Hash, KeyEqual>::Iterator
+    :   public ConstIterator
+{
+    friend class CuckooHashMap;
+
+public:
+    using reference = typename CuckooHashMap::reference;
+    using pointer = typename CuckooHashMap::pointer;
+    using const_reference = typename CuckooHashMap::const_reference;
+    using const_pointer = typename CuckooHashMap::const_pointer;
+
+    Iterator() = default;
+
+    Iterator(CuckooHashMap* map, size_type slot)
+        :   ConstIterator(map, slot)
+    {}
+
+    reference operator*() const
+    {
+        return const_cast<reference>(ConstIterator::operator*());
+    }
+
+    pointer operator->() const
+    {
+        return std::addressof(operator*());
+    }
+
+    Iterator& operator--()
+    {
+        ConstIterator::operator--();
+        return *this;
+    }
+
+    Iterator operator--(int)
+    {
+        const auto result = *this;
+        operator--();
+        return result;
+    }
+
+    Iterator& operator++()
+    {
+        ConstIterator::operator++();
+        return *this;
+    }
+
+    Iterator operator++(int)
+    {
+        const auto result = *this;
+        operator++();
+        return result;
+    }
+};
+
+} // namespace aisdi
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef AISDI_EPOCHDOMAIN_HPP
+#define AISDI_EPOCHDOMAIN_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include <gsl/gsl_assert>
+
+#include "aisdi/Vector.hpp"
+
+namespace aisdi {
+
+namespace detail {
+
+// Process-wide numbers of live threads, so each of them owns one reader
+// slot in every EpochDomain. Numbers of finished threads are reused.
+class ThreadSlots
+{
+public:
+    constexpr static std::size_t Capacity = 256;
+
+    static std::size_t current()
+    {
+        thread_local const Holder holder;
+        return holder.index;
+    }
+
+private:
+    struct Holder
+    {
+        Holder()
+            :   index(acquire())
+        {}
+
+        ~Holder()
+        {
+            release(index);
+        }
+
+        std::size_t index;
+    };
+
+    static std::mutex& mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static bool* used()
+    {
+        static bool used[Capacity] = {};
+        return used;
+    }
+
+    static std::size_t acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        for(auto index = std::size_t{0}; index < Capacity; ++index)
+        {
+            if(!used()[index])
+            {
+                used()[index] = true;
+                return index;
+            }
+        }
+
+        throw std::length_error("Too many threads use epoch domains at once");
+    }
+
+    static void release(std::size_t index) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        used()[index] = false;
+    }
+};
+
+} // namespace detail
+
+// Epoch based reclamation of memory shared with lock-free readers.
+//
+// Readers pin the domain for the duration of each access, which only
+// stores current epoch in a slot owned by their thread (no shared cache
+// line is written). Writers retire objects, which they unlinked, instead
+// of deleting them. Object retired in epoch e is deleted, once the global
+// epoch reaches e + 2, since by then every reader, which could still see
+// it, has unpinned the domain.
+//
+// NOTE: Writers have to be serialized by the caller. A thread must not
+//  pin the same domain twice at once.
+class EpochDomain
+{
+    constexpr static std::uint64_t Inactive = 0;
+    constexpr static std::size_t CacheLineSize = 64;
+
+    struct Slot
+    {
+        std::atomic<std::uint64_t> epoch{Inactive};
+
+        // Slots of different threads never share a cache line
+        char padding[CacheLineSize - sizeof(std::atomic<std::uint64_t>)];
+    };
+
+    struct Retired
+    {
+        std::uint64_t epoch = 0;
+        void* object = nullptr;
+        void (*deleter)(void*) = nullptr;
+    };
+
+public:
+    // Keeps objects visible to this thread alive until destroyed
+    class Guard
+    {
+    public:
+        explicit Guard(std::atomic<std::uint64_t>& slot) noexcept
+            :   slot_(&slot)
+        {}
+
+        Guard(Guard&& other) noexcept
+            :   slot_(other.slot_)
+        {
+            other.slot_ = nullptr;
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard()
+        {
+            if(slot_)
+            {
+                slot_->store(Inactive, std::memory_order_release);
+            }
+        }
+
+    private:
+        std::atomic<std::uint64_t>* slot_;
+    };
+
+    EpochDomain()
+        :   slots_(new Slot[detail::ThreadSlots::Capacity])
+    {}
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // NOTE: No thread may have the domain pinned anymore
+    ~EpochDomain()
+    {
+        for(const auto& retired : retired_)
+        {
+            retired.deleter(retired.object);
+        }
+    }
+
+    Guard pin() const
+    {
+        auto& slot = slots_[detail::ThreadSlots::current()].epoch;
+        Expects(slot.load(std::memory_order_relaxed) == Inactive);
+
+        slot.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        // Announcement has to be visible before any shared pointer is read
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        return Guard{slot};
+    }
+
+    // Schedules deletion of object, which readers may still see.
+    // Called by writers only.
+    template<typename T>
+    void retire(T* object)
+    {
+        if(!object)
+        {
+            return;
+        }
+
+        retired_.append(Retired{epoch_.load(std::memory_order_relaxed),
+                                object,
+                                [](void* pointer) { delete static_cast<T*>(pointer); }});
+    }
+
+    // Advances the epoch, if no reader is behind it, and deletes objects,
+    // which no reader can see anymore. Called by writers only.
+    void collect()
+    {
+        tryAdvance();
+
+        const auto epoch = epoch_.load(std::memory_order_relaxed);
+        auto pending = Vector<Retired>{};
+        for(const auto& retired : retired_)
+        {
+            if(retired.epoch + 2 <= epoch)
+            {
+                retired.deleter(retired.object);
+            }
+            else
+            {
+                pending.append(retired);
+            }
+        }
+
+        retired_ = std::move(pending);
+    }
+
+    std::size_t retired_count() const noexcept
+    {
+        return retired_.size();
+    }
+
+private:
+    void tryAdvance()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const auto epoch = epoch_.load(std::memory_order_relaxed);
+        for(auto index = std::size_t{0}; index < detail::ThreadSlots::Capacity; ++index)
+        {
+            const auto readerEpoch = slots_[index].epoch.load(std::memory_order_acquire);
+            if(readerEpoch != Inactive && readerEpoch != epoch)
+            {
+                return;
+            }
+        }
+
+        epoch_.store(epoch + 1, std::memory_order_seq_cst);
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::uint64_t> epoch_{1};
+    Vector<Retired> retired_;
+};
+
+} // namespace aisdi
+
+#endif
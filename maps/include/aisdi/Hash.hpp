@@ -0,0 +1,239 @@
+#ifndef AISDI_HASH_HPP
+#define AISDI_HASH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+
+#include "aisdi/BucketPolicy.hpp"
+
+namespace aisdi {
+
+namespace detail {
+
+// Secret constants of wyhash
+constexpr std::uint64_t WyPrime0 = UINT64_C(0x2D358DCCAA6C78A5);
+constexpr std::uint64_t WyPrime1 = UINT64_C(0x8BB84B93962EACC9);
+constexpr std::uint64_t WyPrime2 = UINT64_C(0x4B33A62ED433D4A3);
+constexpr std::uint64_t WyPrime3 = UINT64_C(0x4D5A2DA51DE1AA47);
+
+// Full 128 bit product of lhs and rhs, split into its low and high halves
+inline void multiply128(std::uint64_t& lhs, std::uint64_t& rhs) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using Uint128 = unsigned __int128;
+    const auto product = static_cast<Uint128>(lhs) * rhs;
+    lhs = static_cast<std::uint64_t>(product);
+    rhs = static_cast<std::uint64_t>(product >> 64);
+#else
+    const auto lhsHigh = lhs >> 32;
+    const auto lhsLow = lhs & UINT64_C(0xFFFFFFFF);
+    const auto rhsHigh = rhs >> 32;
+    const auto rhsLow = rhs & UINT64_C(0xFFFFFFFF);
+    const auto high = lhsHigh * rhsHigh;
+    const auto middle0 = lhsHigh * rhsLow;
+    const auto middle1 = lhsLow * rhsHigh;
+    const auto low = lhsLow * rhsLow;
+    const auto carry = ((low >> 32) + (middle0 & UINT64_C(0xFFFFFFFF))
+                        + (middle1 & UINT64_C(0xFFFFFFFF))) >> 32;
+    lhs = low + (middle0 << 32) + (middle1 << 32);
+    rhs = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+}
+
+// Folds 128 bit product of lhs and rhs, so every input bit affects
+// about half of the result bits
+inline std::uint64_t multiplyMix(std::uint64_t lhs, std::uint64_t rhs) noexcept
+{
+    multiply128(lhs, rhs);
+    return (lhs ^ rhs);
+}
+
+inline std::uint64_t read64(const unsigned char* bytes) noexcept
+{
+    std::uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t read32(const unsigned char* bytes) noexcept
+{
+    std::uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+// Reads 1 to 3 bytes
+inline std::uint64_t readSmall(const unsigned char* bytes, std::size_t size) noexcept
+{
+    return (static_cast<std::uint64_t>(bytes[0]) << 16)
+        | (static_cast<std::uint64_t>(bytes[size >> 1]) << 8)
+        | bytes[size - 1];
+}
+
+// Seed, which differs between calls and processes. Only the first call
+// asks the system for entropy, the following ones mix in a counter.
+inline std::uint64_t randomSeed()
+{
+    static const std::uint64_t base =
+        (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+    static std::atomic<std::uint64_t> counter{0};
+
+    return mix64(base + WyPrime0 * counter.fetch_add(1, std::memory_order_relaxed));
+}
+
+} // namespace detail
+
+// Hashes bytes with wyhash (final version 4), which reads up to 48 bytes
+// per step. std::hash<std::string> of libstdc++ is MurmurHash2 with
+// a fixed seed, so keys colliding in every process are easy to find.
+inline std::uint64_t hashBytes(const void* data,
+                               std::size_t size,
+                               std::uint64_t seed) noexcept
+{
+    using namespace detail;
+
+    auto bytes = static_cast<const unsigned char*>(data);
+    seed ^= multiplyMix(seed ^ WyPrime0, WyPrime1);
+
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if(size <= 16)
+    {
+        if(size >= 4)
+        {
+            const auto offset = (size >> 3) << 2;
+            a = (read32(bytes) << 32) | read32(bytes + offset);
+            b = (read32(bytes + size - 4) << 32) | read32(bytes + size - 4 - offset);
+        }
+        else if(size > 0)
+        {
+            a = readSmall(bytes, size);
+        }
+    }
+    else
+    {
+        auto remaining = size;
+        if(remaining > 48)
+        {
+            auto seed1 = seed;
+            auto seed2 = seed;
+            do
+            {
+                seed = multiplyMix(read64(bytes) ^ WyPrime1, read64(bytes + 8) ^ seed);
+                seed1 = multiplyMix(read64(bytes + 16) ^ WyPrime2, read64(bytes + 24) ^ seed1);
+                seed2 = multiplyMix(read64(bytes + 32) ^ WyPrime3, read64(bytes + 40) ^ seed2);
+                bytes += 48;
+                remaining -= 48;
+            }
+            while(remaining > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while(remaining > 16)
+        {
+            seed = multiplyMix(read64(bytes) ^ WyPrime1, read64(bytes + 8) ^ seed);
+            bytes += 16;
+            remaining -= 16;
+        }
+
+        a = read64(bytes + remaining - 16);
+        b = read64(bytes + remaining - 8);
+    }
+
+    a ^= WyPrime1;
+    b ^= seed;
+    multiply128(a, b);
+    return multiplyMix(a ^ WyPrime0 ^ size, b ^ WyPrime1);
+}
+
+// Hashes 64 bit integer, so every bit of it affects every bit of result
+// (unlike identity std::hash of libstdc++)
+inline std::uint64_t hashInteger(std::uint64_t value, std::uint64_t seed) noexcept
+{
+    using namespace detail;
+
+    auto a = value ^ WyPrime0;
+    auto b = seed ^ WyPrime1;
+    multiply128(a, b);
+    return multiplyMix(a ^ WyPrime0, b ^ WyPrime1);
+}
+
+// Hashers for HashMap's Hash parameter. Each instance draws its own random
+// seed, so every map hashes differently and keys colliding in one of them
+// (e.g. chosen by an attacker to degrade it, "HashDoS") do not collide in
+// others. Copies share the seed. Pass a hasher constructed with a fixed
+// seed to the map, when hashes have to be reproducible.
+//
+// NOTE: Maps with such hashers compare and merge by looking every key up,
+//  since their seeds differ.
+class StringHash
+{
+public:
+    // Strings may be looked up by const char* without copying them
+    using is_transparent = void;
+
+    StringHash()
+        :   seed_(detail::randomSeed())
+    {}
+
+    explicit StringHash(std::uint64_t seed) noexcept
+        :   seed_(seed)
+    {}
+
+    std::size_t operator()(const std::string& key) const noexcept
+    {
+        return static_cast<std::size_t>(hashBytes(key.data(), key.size(), seed_));
+    }
+
+    std::size_t operator()(const char* key) const noexcept
+    {
+        return static_cast<std::size_t>(hashBytes(key, std::strlen(key), seed_));
+    }
+
+    std::uint64_t seed() const noexcept
+    {
+        return seed_;
+    }
+
+private:
+    std::uint64_t seed_;
+};
+
+template<typename Key>
+class IntegerHash
+{
+    static_assert(std::is_integral<Key>::value || std::is_enum<Key>::value,
+                  "IntegerHash requires integral or enumeration key");
+
+public:
+    IntegerHash()
+        :   seed_(detail::randomSeed())
+    {}
+
+    explicit IntegerHash(std::uint64_t seed) noexcept
+        :   seed_(seed)
+    {}
+
+    std::size_t operator()(Key key) const noexcept
+    {
+        return static_cast<std::size_t>(hashInteger(static_cast<std::uint64_t>(key), seed_));
+    }
+
+    std::uint64_t seed() const noexcept
+    {
+        return seed_;
+    }
+
+private:
+    std::uint64_t seed_;
+};
+
+} // namespace aisdi
+
+#endif
@@ -1,53 +1,299 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
 #include <iterator>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <gsl/gsl_assert>
 
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/instrumentation.hpp"
 #include "aisdi/List.hpp"
-#include "aisdi/Vector.hpp"
+#include "aisdi/Transparent.hpp"
+#include "aisdi/util.hpp"
+#include "aisdi/ValueTraits.hpp"
 
 namespace aisdi {
 
+namespace detail {
+
+struct HashMapProbeTag
+{
+    static const char* name() noexcept { return "HashMap"; }
+};
+
+// Full hash of the key kept in a node
+template<bool Enabled>
+class HashCache
+{
+public:
+    explicit HashCache(std::size_t hash) noexcept
+        :   hash_(hash)
+    {}
+
+    // Tells whether node may hold a key with given hash
+    bool mayMatch(std::size_t hash) const noexcept
+    {
+        return (hash_ == hash);
+    }
+
+    bool mayMatch(const HashCache& other) const noexcept
+    {
+        return (hash_ == other.hash_);
+    }
+
+    template<typename Hash, typename Key>
+    std::size_t hash(const Hash&, const Key&) const noexcept
+    {
+        return hash_;
+    }
+
+    void cache(std::size_t hash) noexcept
+    {
+        hash_ = hash;
+    }
+
+private:
+    std::size_t hash_;
+};
+
+template<>
+class HashCache<false>
+{
+public:
+    explicit HashCache(std::size_t) noexcept
+    {}
+
+    bool mayMatch(std::size_t) const noexcept
+    {
+        return true;
+    }
+
+    bool mayMatch(const HashCache&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename Hash, typename Key>
+    std::size_t hash(const Hash& hasher, const Key& key) const
+    {
+        return hasher(key);
+    }
+
+    void cache(std::size_t) noexcept
+    {}
+};
+
+// Fixed size array of trivially copyable items, for which all-zero bytes
+// make an empty item. It is allocated with calloc, so a large array comes
+// straight from the kernel as zero pages: allocating it takes O(1) time
+// and each page is filled only when its items are first written.
+template<typename T, typename Probe>
+class ZeroedArray
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Items are copied as bytes and never destroyed");
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Items would be misaligned");
+
+public:
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    ZeroedArray() noexcept = default;
+
+    explicit ZeroedArray(size_type size)
+    {
+        if(size == 0)
+        {
+            return;
+        }
+
+        items_ = static_cast<T*>(std::calloc(size, sizeof(T)));
+        if(!items_)
+        {
+            throw std::bad_alloc();
+        }
+
+        size_ = size;
+        Probe::allocated(size_ * sizeof(T));
+    }
+
+    ZeroedArray(const ZeroedArray& other)
+        :   ZeroedArray(other.size_)
+    {
+        std::copy(other.begin(), other.end(), begin());
+    }
+
+    ZeroedArray(ZeroedArray&& other) noexcept
+        :   items_(other.items_)
+        ,   size_(other.size_)
+    {
+        other.items_ = nullptr;
+        other.size_ = 0;
+    }
+
+    ~ZeroedArray()
+    {
+        release();
+    }
+
+    ZeroedArray& operator=(const ZeroedArray& other)
+    {
+        if(&other != this)
+        {
+            *this = ZeroedArray(other);
+        }
+
+        return *this;
+    }
+
+    ZeroedArray& operator=(ZeroedArray&& other) noexcept
+    {
+        if(&other != this)
+        {
+            release();
+
+            items_ = other.items_;
+            size_ = other.size_;
+
+            other.items_ = nullptr;
+            other.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    iterator begin() noexcept
+    {
+        return items_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return items_;
+    }
+
+    iterator end() noexcept
+    {
+        return items_ + size_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return items_ + size_;
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+private:
+    void release() noexcept
+    {
+        if(items_)
+        {
+            Probe::deallocated(size_ * sizeof(T));
+            std::free(items_);
+        }
+
+        items_ = nullptr;
+        size_ = 0;
+    }
+
+    T* items_ = nullptr;
+    size_type size_ = 0;
+};
+
+} // namespace detail
+
+// Tells whether HashMap nodes keep full hashes of their keys, so rehashing
+// does not call Hash again and keys are compared only when hashes match.
+// Hashes of integral, enumeration and pointer keys are cheaper to recompute
+// than to store, so they are not cached. Specialize it to change that choice.
+template<typename Key, typename Hash>
+struct IsHashCached
+    :   std::integral_constant<bool,
+            !(std::is_integral<Key>::value
+                || std::is_enum<Key>::value
+                || std::is_pointer<Key>::value)>
+{};
+
+// Shape of a hash table, as reported by HashMap::stats() and HashSet::stats()
+struct HashTableStats
+{
+    std::size_t size = 0;
+    std::size_t bucketCount = 0;
+
+    // Number of buckets looked at, all of them unless stats were sampled
+    std::size_t sampledBuckets = 0;
+
+    // bucketSizes[n] is the number of sampled buckets holding n items
+    std::vector<std::size_t> bucketSizes;
+    std::size_t maxChainLength = 0;
+    double emptyBucketRatio = 0.0;
+
+    // Nodes visited by a lookup of a present key and of a missing one,
+    // assuming every key (and every bucket) is equally likely
+    double meanSuccessfulProbes = 0.0;
+    double meanUnsuccessfulProbes = 0.0;
+
+    std::size_t memoryBytes = 0;
+};
+
+namespace detail {
+
+// Internals of HashMap and HashSet, which differ only in items kept by
+// nodes (see ValueTraits.hpp) and in operations on mapped values
 template<typename Key,
-         typename T,
-         typename Hash = std::hash<Key>,
-         typename KeyEqual = std::equal_to<Key>>
-class HashMap
+         typename ValueTraits,
+         typename Hash,
+         typename KeyEqual,
+         typename BucketPolicy>
+class HashTable
 {
 public:
     using key_type = Key;
-    using mapped_type = T;
-    using value_type = std::pair<const Key, T>;
+    using value_type = typename ValueTraits::value_type;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using hasher = Hash;
     using key_equal = KeyEqual;
-    using reference = value_type&;
+    using bucket_policy = BucketPolicy;
+    using reference = typename ValueTraits::reference;
     using const_reference = const value_type&;
-    using pointer = value_type*;
+    using pointer = typename ValueTraits::pointer;
     using const_pointer = const value_type*;
 
     struct Node
+        :   public detail::HashCache<IsHashCached<Key, Hash>::value>
     {
+        template<typename... Args>
+        explicit Node(std::size_t hash, Args&&... args)
+            :   detail::HashCache<IsHashCached<Key, Hash>::value>(hash)
+            ,   value(std::forward<Args>(args)...)
+        {}
+
         value_type value;
 
         const key_type& key() const
         {
-            return value.first;
-        }
-
-        const mapped_type& mapped() const
-        {
-            return value.second;
-        }
-
-        mapped_type& mapped()
-        {
-            return value.second;
+            return ValueTraits::key(value);
         }
     };
 
@@ -55,84 +301,126 @@ private:
     friend class ConstIterator;
     friend class Iterator;
 
-    using Bucket = aisdi::List<Node>;
-    using HashTable = aisdi::Vector<Bucket>;
+    template<typename K, typename V, typename H, typename E, typename B>
+    friend bool operator==(const HashTable<K, V, H, E, B>& lhs,
+                           const HashTable<K, V, H, E, B>& rhs);
+
+    using Probe = instrumentation::Probe<detail::HashMapProbeTag>;
 
-    using BucketIterator = typename HashTable::iterator;
-    using ConstBucketIterator = typename HashTable::const_iterator;
-    using NodeIterator = typename Bucket::iterator;
-    using ConstNodeIterator = typename Bucket::const_iterator;
+    // NOTE: All nodes are kept in a single list, in which nodes of each
+    //  bucket are adjacent. Bucket refers to its first node, so lookups walk
+    //  only its own chain, while iteration walks the list and never visits
+    //  empty buckets.
+    using Nodes = aisdi::List<Node>;
+    using NodeIterator = typename Nodes::iterator;
+    using ConstNodeIterator = typename Nodes::const_iterator;
 
+    // All-zero bytes make an empty bucket (a singular iterator holds
+    // a null pointer), so new bucket arrays need not be filled
+    struct Bucket
+    {
+        NodeIterator first;
+        size_type size = 0;
+    };
+
+    using Buckets = detail::ZeroedArray<Bucket, Probe>;
+    using BucketIterator = typename Buckets::iterator;
+
+protected:
     constexpr static size_type DefaultBucketCount = 10;
     constexpr static float DefaultMaxLoadFactor = 1.0f;
+    constexpr static size_type GrowthFactor = 2;
+    constexpr static size_type FindBatchSize = 16;
+    // Old buckets moved by each insertion in incremental mode
+    constexpr static size_type MigrationStep = 4;
 
 public:
     class Iterator;
     class ConstIterator;
+    class NodeHandle;
+    struct InsertReturnType;
 
     using iterator = Iterator;
     using const_iterator = ConstIterator;
-    using node_type = Node;
+    using node_type = NodeHandle;
+    using insert_return_type = InsertReturnType;
+
+protected:
+    // Lookups by any K are enabled, when both Hash and KeyEqual are
+    // transparent. Iterators are excluded, so erase(pos) is not hijacked.
+    template<typename K, typename H = Hash, typename E = KeyEqual>
+    using EnableIfTransparent =
+        std::enable_if_t<detail::IsTransparent<H>::value
+                         && detail::IsTransparent<E>::value
+                         && !std::is_convertible<K, const_iterator>::value>;
 
-    explicit HashMap(size_type bucketCount = DefaultBucketCount)
+public:
+    explicit HashTable(size_type bucketCount = DefaultBucketCount)
     {
         init(bucketCount);
     }
 
-    template<typename InputIt>
-    HashMap(InputIt first, InputIt last,
-            size_type bucketCount = DefaultBucketCount)
-        :   HashMap(bucketCount)
+    // Uses given function objects, e.g. a hasher with a chosen seed
+    HashTable(size_type bucketCount,
+              const hasher& hash,
+              const key_equal& equal = key_equal())
+        :   HashTable(bucketCount)
     {
-        std::for_each(first, last,
-                      [this](const auto& value)
-                      {
-                          const auto& key = value.first;
-                          const auto& mapped = value.second;
-                          this->operator[](key) = mapped;
-                      });
+        hasher_ = hash;
+        keyEqual_ = equal;
     }
 
-    ~HashMap() = default;
+    ~HashTable() = default;
 
-    HashMap(const HashMap& other)
+    HashTable(const HashTable& other)
     {
         *this = other;
     }
 
-    HashMap(HashMap&& other) noexcept
+    HashTable(HashTable&& other) noexcept
     {
         *this = std::move(other);
     }
 
-    HashMap(std::initializer_list<value_type> init,
-            size_type bucketCount = DefaultBucketCount)
-        :   HashMap(init.begin(), init.end(), bucketCount)
-    {}
-
-    HashMap& operator=(const HashMap& other)
+    HashTable& operator=(const HashTable& other)
     {
         if(&other != this)
         {
-            hashTable_ = other.hashTable_;
+            nodes_ = other.nodes_;
+            buckets_ = other.buckets_;
             maxLoadFactor_ = other.maxLoadFactor_;
             size_ = other.size_;
             keyEqual_ = other.keyEqual_;
             hasher_ = other.hasher_;
+            bucketPolicy_ = other.bucketPolicy_;
+            oldBuckets_ = other.oldBuckets_;
+            oldBucketPolicy_ = other.oldBucketPolicy_;
+            migrated_ = other.migrated_;
+            incremental_ = other.incremental_;
+
+            // Copied buckets still refer to nodes of the other map
+            relinkBuckets();
         }
 
         return *this;
     }
 
-    HashMap& operator=(HashMap&& other) noexcept
+    HashTable& operator=(HashTable&& other) noexcept
     {
         if(&other != this)
         {
-            hashTable_ = std::move(other.hashTable_);
+            // NOTE: Nodes are not relocated, so buckets still refer to them
+            nodes_ = std::move(other.nodes_);
+            buckets_ = std::move(other.buckets_);
             maxLoadFactor_ = other.maxLoadFactor_;
             size_ = other.size_;
             keyEqual_ = std::move(other.keyEqual_);
             hasher_ = std::move(other.hasher_);
+            bucketPolicy_ = other.bucketPolicy_;
+            oldBuckets_ = std::move(other.oldBuckets_);
+            oldBucketPolicy_ = other.oldBucketPolicy_;
+            migrated_ = other.migrated_;
+            incremental_ = other.incremental_;
 
             other.init();
         }
@@ -142,21 +430,12 @@ public:
 
     iterator begin()
     {
-        Expects(hashTable_.size() > 0);
-
-        auto bucketPos = hashTable_.begin();
-        const auto lastBucketPos = std::prev(hashTable_.end());
-        while(bucketPos->empty() && (bucketPos != lastBucketPos))
-        {
-            ++bucketPos;
-        }
-
-        return {bucketPos, bucketPos->begin(), *this};
+        return iterator{nodes_.begin()};
     }
 
     const_iterator begin() const
     {
-        return const_cast<HashMap&>(*this).begin();
+        return const_cast<HashTable&>(*this).begin();
     }
 
     const_iterator cbegin() const
@@ -166,15 +445,12 @@ public:
 
     iterator end()
     {
-        Expects(hashTable_.size() > 0);
-        const auto bucketPos = std::prev(hashTable_.end());
-        const auto nodePos = bucketPos->begin();
-        return Iterator{bucketPos, nodePos, *this};
+        return iterator{nodes_.end()};
     }
 
     const_iterator end() const
     {
-        return const_cast<HashMap&>(*this).end();
+        return const_cast<HashTable&>(*this).end();
     }
 
     const_iterator cend() const
@@ -182,139 +458,173 @@ public:
         return end();
     }
 
-    T& at(const key_type& key)
+    // Returns position of the item with key of value and whether it was
+    // inserted, so a key is both checked and added with a single lookup
+    std::pair<iterator, bool> insert(const value_type& value)
     {
-        auto pos = find(key);
-        if(pos == end())
+        return emplaceKey(ValueTraits::key(value), value);
+    }
+
+    // Links node of the handle, unless its key is already present. Then
+    // the handle is given back in the result. Nothing is allocated or copied.
+    insert_return_type insert(node_type&& node)
+    {
+        if(node.empty())
         {
-            throw std::out_of_range("Key not exist");
+            return {end(), false, node_type{}};
         }
 
-        return pos->second;
+        const auto nodePos = node.nodes_.begin();
+        const auto hash = foreignHash(*nodePos);
+        const auto location = locate(nodePos->key(), hash);
+        if(location.second != nodes_.end())
+        {
+            return {iterator{location.second}, false, std::move(node)};
+        }
+
+        const auto bucketPos = prepareBucket(hash, location.first);
+        return {linkNode(hash, bucketPos, node.nodes_, nodePos), true, node_type{}};
     }
 
-    const T& at(const key_type& key) const
+    // Unlinks node at pos and hands it over without copying its item
+    node_type extract(const const_iterator& pos)
     {
-        return const_cast<HashMap&>(*this).at(key);
+        Expects(pos != end());
+
+        auto node = node_type{};
+        unlinkNode(pos.nodePos_);
+        node.nodes_.splice(node.nodes_.end(), nodes_, pos.nodePos_);
+        return node;
     }
 
-    T& operator[](const key_type& key)
+    node_type extract(const key_type& key)
     {
-        const auto result = insert({key, mapped_type{}});
-        const auto pos = result.first;
-        auto& mapped = pos->second;
-        return mapped;
+        const auto pos = find(key);
+        return (pos != end()) ? extract(pos) : node_type{};
     }
 
-    std::pair<iterator, bool> insert(const value_type& value)
+    // Moves nodes of the other table, whose keys are not present in this
+    // one, by relinking them. Other items stay where they were.
+    void merge(HashTable& other)
     {
-        const auto& key = value.first;
-        const auto location = locate(key);
-        const auto& bucketPos = location.first; // Replace these two lines in C++17
-        const auto& nodePos = location.second;
-        const auto bucketEnd = bucketPos->end();
-        if(nodePos != bucketEnd)
+        if(&other == this)
         {
-            return {iterator{bucketPos, nodePos, *this}, false};
+            return;
         }
 
-        const auto& mapped = value.second;
-        const auto node = Node{{std::piecewise_construct,
-                                std::forward_as_tuple(key),
-                                std::forward_as_tuple(mapped)}};
-        const auto insertedNodePos = bucketPos->insert(bucketEnd, node);
-        ++size_;
-
-        return {iterator{bucketPos, insertedNodePos, *this}, true};
-    }
-
-    template<class M>
-    iterator insert_or_assign(const key_type& key, M&& obj)
-    {
-        const auto location = locate(key);
-        const auto& bucketPos = location.first; // Replace these two lines in C++17
-        const auto& nodePos = location.second;
-        const auto bucketEnd = bucketPos->end();
-        if(nodePos != bucketEnd)
+        for(auto nodePos = other.nodes_.begin(); nodePos != other.nodes_.end();)
         {
-            nodePos->mapped() = std::move(obj);
-            return iterator{bucketPos, nodePos, *this};
+            const auto current = nodePos++;
+            const auto hash = foreignHash(*current);
+            const auto location = locate(current->key(), hash);
+            if(location.second == nodes_.end())
+            {
+                // Table grows before the node leaves the other one,
+                // so failed growth leaves both of them intact
+                const auto bucketPos = prepareBucket(hash, location.first);
+                other.unlinkNode(current);
+                linkNode(hash, bucketPos, other.nodes_, current);
+            }
         }
+    }
 
-        const auto node = Node{{std::piecewise_construct,
-                                std::forward_as_tuple(key),
-                                std::forward_as_tuple(std::forward<M>(obj))}};
-        const auto insertedNodePos = bucketPos->insert(bucketEnd, node);
-        ++size_;
-
-        return iterator{bucketPos, insertedNodePos, *this};
+    void merge(HashTable&& other)
+    {
+        merge(other);
     }
 
     iterator erase(const const_iterator& pos)
     {
-        auto bucketPos = pos.bucketPos_;
-        auto nodePos = pos.nodePos_;
-        auto nextNodePos = bucketPos->erase(nodePos);
-        --size_;
-        const auto lastBucketPos = std::prev(hashTable_.end());
-        while((nextNodePos == bucketPos->end())
-            && (bucketPos != lastBucketPos))
-        {
-            ++bucketPos;
-            nodePos = bucketPos->begin();
-        }
+        Expects(pos != end());
 
-        return iterator{bucketPos, nodePos, *this};
+        const auto nodePos = pos.nodePos_;
+        unlinkNode(nodePos);
+        return iterator{nodes_.erase(nodePos)};
     }
 
     size_type erase(const key_type& key)
     {
-        auto pos = find(key);
-        if(pos == end())
-        {
-            return 0;
-        }
+        return eraseKey(key);
+    }
 
-        erase(pos);
-        return 1;
+    template<typename K, typename = EnableIfTransparent<K>>
+    size_type erase(const K& key)
+    {
+        return eraseKey(key);
     }
 
-    bool contains(const key_type& key)
+    bool contains(const key_type& key) const
     {
         return (find(key) != end());
     }
 
-    iterator find(const key_type& key)
+    template<typename K, typename = EnableIfTransparent<K>>
+    bool contains(const K& key) const
     {
-        const auto location = locate(key);
-        const auto& bucketPos = location.first; // Replace these two lines in C++17
-        const auto& nodePos = location.second;
-        Expects(bucketPos != hashTable_.end());
-        if(nodePos == bucketPos->end())
-        {
-            return end();
-        }
+        return (find(key) != end());
+    }
+
+    size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    size_type count(const K& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
 
-        return iterator{bucketPos, nodePos, *this};
+    iterator find(const key_type& key)
+    {
+        return findKey(key);
     }
 
     const_iterator find(const key_type& key) const
     {
-        return const_cast<HashMap&>(*this).find(key);
+        return const_cast<HashTable&>(*this).findKey(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    iterator find(const K& key)
+    {
+        return findKey(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    const_iterator find(const K& key) const
+    {
+        return const_cast<HashTable&>(*this).findKey(key);
+    }
+
+    // Looks up every key in [keysFirst, keysLast) and writes its iterator
+    // (or end(), if key is missing) to out. Keys are processed in batches:
+    // all hashes are computed first, then buckets and their first nodes are
+    // prefetched, so cache misses of different keys overlap instead of
+    // following one another.
+    template<typename ForwardIt, typename OutputIt>
+    OutputIt find_many(ForwardIt keysFirst, ForwardIt keysLast, OutputIt out)
+    {
+        return findMany<iterator>(keysFirst, keysLast, out);
+    }
+
+    template<typename ForwardIt, typename OutputIt>
+    OutputIt find_many(ForwardIt keysFirst, ForwardIt keysLast, OutputIt out) const
+    {
+        auto& self = const_cast<HashTable&>(*this);
+        return self.template findMany<const_iterator>(keysFirst, keysLast, out);
     }
 
     size_type bucket(const Key& key) const
     {
-        Expects(bucket_count() > 0);
-        const auto hash = hasher_(key);
-        return (hash % bucket_count());
+        return bucketIndex(hasher_(key));
     }
 
     float load_factor() const
     {
         Expects(bucket_count() > 0);
         const auto bucketCount = static_cast<float>(bucket_count());
-        return (size() / bucketCount);
+        return (static_cast<float>(size()) / bucketCount);
     }
 
     float max_load_factor() const noexcept
@@ -324,12 +634,176 @@ public:
 
     void max_load_factor(float maxLoadFactor)
     {
+        Expects(maxLoadFactor > 0.0f);
         maxLoadFactor_ = maxLoadFactor;
     }
 
+    // Redistributes items into at least bucketCount buckets (and at least
+    // as many as max_load_factor() requires). Nodes are relinked, not copied,
+    // and cached hashes are reused. Invalidates iterators.
+    void rehash(size_type bucketCount)
+    {
+        migrate(oldBuckets_.size());
+
+        const auto minBucketCount = static_cast<size_type>(
+            std::ceil(static_cast<float>(size_) / maxLoadFactor_));
+        bucketCount = BucketPolicy::bucketCount(std::max(bucketCount, minBucketCount));
+        if(bucketCount == bucket_count())
+        {
+            return;
+        }
+
+        auto bucketPolicy = BucketPolicy{};
+        bucketPolicy.reset(bucketCount);
+        auto buckets = Buckets(bucketCount);
+        auto nodes = Nodes{};
+        while(!nodes_.empty())
+        {
+            const auto nodePos = nodes_.begin();
+            const auto bucketIndex = bucketPolicy.index(hashOf(*nodePos));
+            auto& bucket = *std::next(buckets.begin(),
+                                      static_cast<difference_type>(bucketIndex));
+            nodes.splice(bucket.size > 0 ? bucket.first : nodes.begin(), nodes_, nodePos);
+            bucket.first = nodePos;
+            ++bucket.size;
+        }
+
+        nodes_ = std::move(nodes);
+        buckets_ = std::move(buckets);
+        bucketPolicy_ = bucketPolicy;
+
+        Ensures(bucket_count() == bucketCount);
+    }
+
+    // Prepares map for count items without exceeding max_load_factor()
+    void reserve(size_type count)
+    {
+        rehash(static_cast<size_type>(
+            std::ceil(static_cast<float>(count) / maxLoadFactor_)));
+    }
+
+    // In incremental mode growing table does not relink all nodes at once.
+    // Old table is kept next to the new one and each insertion moves a few
+    // of its buckets, so no single insertion pays for the whole rehash.
+    // Lookups route keys of buckets, which were not moved yet, to the old
+    // table. Explicit rehash() and reserve() still finish at once.
+    // New bucket array is allocated as zero pages, which are not filled
+    // up front, so growing takes O(1) apart from buckets moved on the way.
+    // NOTE: Insertion moving the last old bucket frees the old array, which
+    //  gives its pages back to the system (a few ms for 5M buckets).
+    void incremental_rehash(bool enabled) noexcept
+    {
+        incremental_ = enabled;
+    }
+
+    bool incremental_rehash() const noexcept
+    {
+        return incremental_;
+    }
+
+    // Tells whether items are still being moved from the old table.
+    // Bucket interface (bucket_count(), bucket(), ...) describes the new one.
+    bool rehashing() const noexcept
+    {
+        return !oldBuckets_.empty();
+    }
+
     size_type bucket_count() const noexcept
     {
-        return (hashTable_.size() - 1);
+        return buckets_.size();
+    }
+
+    size_type bucket_size(size_type bucketIndex) const
+    {
+        Expects(bucketIndex < bucket_count());
+        return std::next(buckets_.begin(),
+                         static_cast<difference_type>(bucketIndex))->size;
+    }
+
+    // Describes chains of all buckets. Reads only the bucket array, never
+    // the nodes, so it takes O(bucket_count()) and may be called periodically
+    // on a live map. While rehashing, buckets of the old table, which were
+    // not moved yet, are counted as well.
+    HashTableStats stats() const
+    {
+        return stats(buckets_.size() + oldBuckets_.size());
+    }
+
+    // Same as stats(), but looks at no more than about sampleSize buckets,
+    // spread evenly over the table. Size and memory footprint stay exact.
+    HashTableStats stats(size_type sampleSize) const
+    {
+        Expects(sampleSize > 0);
+
+        auto result = HashTableStats{};
+        result.size = size_;
+        result.bucketCount = bucket_count();
+        result.memoryBytes = memory_bytes();
+
+        const auto stride = std::max<size_type>(
+            (buckets_.size() + oldBuckets_.size()) / sampleSize, 1);
+        auto items = size_type{0};
+        auto successfulProbes = size_type{0};
+        auto countBuckets = [&](auto first, size_type bucketCount)
+            {
+                for(auto index = size_type{0}; index < bucketCount; index += stride)
+                {
+                    const auto chainLength =
+                        std::next(first, static_cast<difference_type>(index))->size;
+                    if(chainLength >= result.bucketSizes.size())
+                    {
+                        result.bucketSizes.resize(chainLength + 1);
+                    }
+
+                    ++result.bucketSizes[chainLength];
+                    ++result.sampledBuckets;
+                    items += chainLength;
+                    // Key of the n-th node of a chain is found after n probes
+                    successfulProbes += chainLength * (chainLength + 1) / 2;
+                }
+            };
+        countBuckets(buckets_.begin(), buckets_.size());
+        if(rehashing())
+        {
+            countBuckets(std::next(oldBuckets_.begin(),
+                                   static_cast<difference_type>(migrated_)),
+                         oldBuckets_.size() - migrated_);
+        }
+
+        if(result.sampledBuckets > 0)
+        {
+            const auto sampledBuckets = static_cast<double>(result.sampledBuckets);
+            result.maxChainLength = result.bucketSizes.size() - 1;
+            result.emptyBucketRatio =
+                static_cast<double>(result.bucketSizes.front()) / sampledBuckets;
+            // Missing key is compared with every node of its chain
+            result.meanUnsuccessfulProbes = static_cast<double>(items) / sampledBuckets;
+        }
+
+        if(items > 0)
+        {
+            result.meanSuccessfulProbes =
+                static_cast<double>(successfulProbes) / static_cast<double>(items);
+        }
+
+        return result;
+    }
+
+    // Bytes taken by the map, its buckets and nodes. Allocator overhead and
+    // memory owned by keys and values (e.g. long strings) are not counted.
+    size_type memory_bytes() const noexcept
+    {
+        // List node adds links to the previous and the next node
+        struct ListNode
+        {
+            void* prev;
+            void* next;
+            Node node;
+        };
+
+        return sizeof(*this)
+            + (buckets_.size() + oldBuckets_.size()) * sizeof(Bucket)
+            + size_ * sizeof(ListNode);
     }
 
     bool empty() const noexcept
@@ -342,12 +816,52 @@ public:
         return size_;
     }
 
+    hasher hash_function() const
+    {
+        return hasher_;
+    }
+
+    key_equal key_eq() const
+    {
+        return keyEqual_;
+    }
+
+protected:
+    template<typename K>
+    iterator findKey(const K& key)
+    {
+        const auto location = locate(key, hasher_(key));
+        return iterator{location.second};
+    }
+
+    // Returns node of the key, or a new one constructed of args, if key
+    // is missing. Args are not used, when key is present.
+    template<typename... Args>
+    std::pair<iterator, bool> emplaceKey(const key_type& key, Args&&... args)
+    {
+        const auto hash = hasher_(key);
+        const auto location = locate(key, hash);
+        const auto& bucketPos = location.first; // Replace these two lines in C++17
+        const auto& nodePos = location.second;
+        if(nodePos != nodes_.end())
+        {
+            return {iterator{nodePos}, false};
+        }
+
+        return {emplaceNode(hash, bucketPos, std::forward<Args>(args)...), true};
+    }
+
 private:
     void init(size_type bucketCount = DefaultBucketCount)
     {
-        Expects(hashTable_.empty());
-
-        hashTable_.resize(bucketCount + 1);
+        Expects(buckets_.empty());
+        Expects(oldBuckets_.empty());
+        Expects(nodes_.empty());
+
+        bucketCount = BucketPolicy::bucketCount(bucketCount);
+        bucketPolicy_.reset(bucketCount);
+        buckets_ = Buckets(bucketCount);
+        migrated_ = 0;
         maxLoadFactor_ = DefaultMaxLoadFactor;
         size_ = 0;
         keyEqual_ = key_equal();
@@ -358,94 +872,383 @@ private:
         Ensures(size() == 0);
     }
 
-    std::pair<BucketIterator, NodeIterator> locate(const key_type& key)
+    std::size_t hashOf(const Node& node) const
+    {
+        return node.hash(hasher_, node.key());
+    }
+
+    // Returns bucket of the key and its node, or end of nodes, if key is missing.
+    // K is key_type, unless Hash and KeyEqual are transparent.
+    template<typename K>
+    std::pair<BucketIterator, NodeIterator> locate(const K& key, std::size_t hash)
+    {
+        return locateIn(bucketPosAt(hash), key, hash);
+    }
+
+    // Same as locate(), when bucket of the hash is already known
+    template<typename K>
+    std::pair<BucketIterator, NodeIterator> locateIn(BucketIterator bucketPos,
+                                                     const K& key,
+                                                     std::size_t hash)
     {
-        const auto bucketPos = bucketPosAt(key);
-        const auto bucketBegin = bucketPos->begin();
-        const auto bucketEnd = bucketPos->end();
-        const auto nodePos =
-            std::find_if(bucketBegin, bucketEnd,
-                        [&key, this](const auto& node)
-                        {
-                            return keyEqual_(key, node.key());
-                        });
+        auto nodePos = bucketPos->first;
+        for(auto count = bucketPos->size; count > 0; --count, ++nodePos)
+        {
+            // Cached hashes rule out most keys without comparing them
+            if(nodePos->mayMatch(hash) && keyEqual_(key, nodePos->key()))
+            {
+                return std::make_pair(bucketPos, nodePos);
+            }
+        }
+
+        return std::make_pair(bucketPos, nodes_.end());
+    }
+
+    template<typename K>
+    size_type eraseKey(const K& key)
+    {
+        auto pos = findKey(key);
+        if(pos == end())
+        {
+            return 0;
+        }
 
-        return std::make_pair(bucketPos, nodePos);
+        erase(pos);
+        return 1;
     }
 
-    std::pair<ConstBucketIterator, ConstNodeIterator> locate(const key_type& key) const
+    // Writes Result (iterator or const_iterator) of every key to out
+    template<typename Result, typename ForwardIt, typename OutputIt>
+    OutputIt findMany(ForwardIt keysFirst, ForwardIt keysLast, OutputIt out)
     {
-        return const_cast<HashMap&>(*this).locate(key);
+        ForwardIt keys[FindBatchSize];
+        std::size_t hashes[FindBatchSize];
+        BucketIterator bucketPositions[FindBatchSize];
+
+        while(keysFirst != keysLast)
+        {
+            auto count = size_type{0};
+            for(; count < FindBatchSize && keysFirst != keysLast; ++count, ++keysFirst)
+            {
+                keys[count] = keysFirst;
+                hashes[count] = hasher_(*keysFirst);
+                bucketPositions[count] = bucketPosAt(hashes[count]);
+                util::prefetch(std::addressof(*bucketPositions[count]));
+            }
+
+            for(auto i = size_type{0}; i < count; ++i)
+            {
+                const auto& bucket = *bucketPositions[i];
+                if(bucket.size > 0)
+                {
+                    util::prefetch(std::addressof(*bucket.first));
+                }
+            }
+
+            for(auto i = size_type{0}; i < count; ++i)
+            {
+                const auto location = locateIn(bucketPositions[i], *keys[i], hashes[i]);
+                *out++ = Result{location.second};
+            }
+        }
+
+        return out;
     }
 
-    BucketIterator bucketPosAt(const key_type& key)
+    size_type bucketIndex(std::size_t hash) const
     {
-        const auto bucketIndex = bucket(key);
+        return bucketPolicy_.index(hash);
+    }
+
+    // Returns bucket holding keys with given hash. While rehashing, keys of
+    // old buckets, which were not moved yet, are still in the old table.
+    BucketIterator bucketPosAt(std::size_t hash)
+    {
+        if(rehashing())
+        {
+            const auto oldBucketPos =
+                std::next(oldBuckets_.begin(),
+                          static_cast<difference_type>(oldBucketPolicy_.index(hash)));
+            if(oldBucketPos->size > 0)
+            {
+                return oldBucketPos;
+            }
+        }
+
+        const auto bucketIndex = this->bucketIndex(hash);
         Ensures(bucketIndex < bucket_count());
-        const auto bucketPos = std::next(hashTable_.begin(),
-                                         static_cast<difference_type>(bucketIndex));
-        Ensures(bucketPos != hashTable_.end());
+        return std::next(buckets_.begin(), static_cast<difference_type>(bucketIndex));
+    }
+
+    template<typename... Args>
+    iterator emplaceNode(std::size_t hash, BucketIterator bucketPos, Args&&... args)
+    {
+        bucketPos = prepareBucket(hash, bucketPos);
+        auto nodes = Nodes{};
+        nodes.append(Node(hash, std::forward<Args>(args)...));
+        return linkNode(hash, bucketPos, nodes, nodes.begin());
+    }
+
+    // Grows the table, if one more item would exceed max_load_factor(),
+    // and returns bucket of the hash
+    BucketIterator prepareBucket(std::size_t hash, BucketIterator bucketPos)
+    {
+        const auto maxSize = static_cast<float>(bucket_count()) * maxLoadFactor_;
+        if(static_cast<float>(size_ + 1) > maxSize)
+        {
+            grow();
+            return bucketPosAt(hash);
+        }
+
         return bucketPos;
     }
 
-    ConstBucketIterator bucketPosAt(const key_type& key) const
+    // Moves node from given list in front of its bucket (see prepareBucket())
+    iterator linkNode(std::size_t hash, BucketIterator bucketPos,
+                      Nodes& nodes, NodeIterator nodePos)
+    {
+        auto& bucket = *bucketPos;
+        nodePos->cache(hash);
+        nodes_.splice(bucket.size > 0 ? bucket.first : nodes_.begin(), nodes, nodePos);
+        bucket.first = nodePos;
+        ++bucket.size;
+        ++size_;
+        Probe::sized(size_);
+        Probe::chained(bucket.size);
+
+        const auto result = iterator{bucket.first};
+        migrate(MigrationStep);
+        return result;
+    }
+
+    // Removes node from its bucket, but leaves it in the list of nodes
+    void unlinkNode(NodeIterator nodePos)
+    {
+        auto& bucket = *bucketPosAt(hashOf(*nodePos));
+        Expects(bucket.size > 0);
+        if(bucket.first == nodePos)
+        {
+            bucket.first = (bucket.size > 1) ? std::next(nodePos) : NodeIterator{};
+        }
+
+        --bucket.size;
+        --size_;
+    }
+
+    // Returns hash of a node coming from another table. Hash cached there
+    // is reused, unless hashers are stateful, so they may disagree.
+    std::size_t foreignHash(const Node& node) const
     {
-        return const_cast<HashMap&>(*this).bucketPosAt(key);
+        return std::is_empty<Hash>::value ? hashOf(node) : hasher_(node.key());
     }
 
-    HashTable hashTable_;
+    void grow()
+    {
+        const auto bucketCount = bucket_count() * GrowthFactor;
+        if(!incremental_)
+        {
+            rehash(bucketCount);
+            return;
+        }
+
+        // Previous migration has to end before the next one starts
+        migrate(oldBuckets_.size());
+
+        oldBuckets_ = std::move(buckets_);
+        oldBucketPolicy_ = bucketPolicy_;
+        migrated_ = 0;
+
+        buckets_ = Buckets(BucketPolicy::bucketCount(bucketCount));
+        bucketPolicy_.reset(buckets_.size());
+    }
+
+    // Moves nodes of next count old buckets to the new table, or drops
+    // the old table, when all its buckets are moved
+    void migrate(size_type count)
+    {
+        if(!rehashing())
+        {
+            return;
+        }
+
+        for(; count > 0 && migrated_ < oldBuckets_.size(); --count, ++migrated_)
+        {
+            auto& oldBucket = *std::next(oldBuckets_.begin(),
+                                         static_cast<difference_type>(migrated_));
+            while(oldBucket.size > 0)
+            {
+                const auto nodePos = oldBucket.first;
+                oldBucket.first = (--oldBucket.size > 0) ? std::next(nodePos) : NodeIterator{};
+
+                const auto bucketIndex = this->bucketIndex(hashOf(*nodePos));
+                auto& bucket = *std::next(buckets_.begin(),
+                                          static_cast<difference_type>(bucketIndex));
+                nodes_.splice(bucket.size > 0 ? bucket.first : nodes_.begin(), nodes_, nodePos);
+                bucket.first = nodePos;
+                ++bucket.size;
+            }
+        }
+
+        if(migrated_ == oldBuckets_.size())
+        {
+            oldBuckets_ = Buckets{};
+            migrated_ = 0;
+        }
+    }
+
+    // Points buckets at nodes of this map, which are grouped by bucket.
+    // Sizes of buckets are already right, only their first nodes are not.
+    void relinkBuckets()
+    {
+        for(auto buckets : {&buckets_, &oldBuckets_})
+        {
+            for(auto& bucket : *buckets)
+            {
+                bucket.first = NodeIterator{};
+            }
+        }
+
+        for(auto nodePos = nodes_.begin(); nodePos != nodes_.end(); ++nodePos)
+        {
+            auto& bucket = *bucketPosAt(hashOf(*nodePos));
+            if(bucket.first == NodeIterator{})
+            {
+                bucket.first = nodePos;
+            }
+        }
+    }
+
+    // Compares items of maps with the same layout bucket by bucket,
+    // so neither keys nor hashes have to be computed again
+    bool equalBuckets(const HashTable& other) const
+    {
+        Expects(bucket_count() == other.bucket_count());
+
+        const auto sameSizes = std::equal(buckets_.begin(), buckets_.end(),
+                                          other.buckets_.begin(),
+                                          [](const auto& lhs, const auto& rhs)
+                                          {
+                                              return (lhs.size == rhs.size);
+                                          });
+        if(!sameSizes)
+        {
+            return false;
+        }
+
+        auto otherBucketPos = other.buckets_.begin();
+        for(const auto& bucket : buckets_)
+        {
+            const auto& otherBucket = *otherBucketPos++;
+            auto nodePos = ConstNodeIterator{bucket.first};
+            for(auto count = bucket.size; count > 0; --count, ++nodePos)
+            {
+                const auto& node = *nodePos;
+                const auto otherFirst = ConstNodeIterator{otherBucket.first};
+                const auto otherLast = std::next(otherFirst,
+                                                 static_cast<difference_type>(otherBucket.size));
+                const auto otherNodePos =
+                    std::find_if(otherFirst, otherLast,
+                                 [&node, this](const auto& otherNode)
+                                 {
+                                     return otherNode.mayMatch(node)
+                                         && keyEqual_(node.key(), otherNode.key());
+                                 });
+                if(otherNodePos == otherLast
+                   || !ValueTraits::equalMapped(node.value, otherNodePos->value))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    Nodes nodes_;
+    Buckets buckets_;
     float maxLoadFactor_;
     size_type size_;
     key_equal keyEqual_;
     hasher hasher_;
+    bucket_policy bucketPolicy_;
+
+    // Table, which is being moved to buckets_ in incremental mode.
+    // Buckets before migrated_ are already empty.
+    Buckets oldBuckets_;
+    bucket_policy oldBucketPolicy_;
+    size_type migrated_ = 0;
+    bool incremental_ = false;
 };
 
+// NOTE: Iteration order depends on history of the maps,
+//  so items are looked up in the other map instead. O(size) expected.
 template<typename Key,
-         typename T,
+         typename ValueTraits,
          typename Hash,
-         typename KeyEqual>
-bool operator==(const HashMap<Key, T, Hash, KeyEqual>& lhs,
-                const HashMap<Key, T, Hash, KeyEqual>& rhs)
+         typename KeyEqual,
+         typename BucketPolicy>
+bool operator==(const HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>& lhs,
+                const HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>& rhs)
 {
+    if(&lhs == &rhs)
+    {
+        return true;
+    }
+
     if(lhs.size() != rhs.size())
     {
         return false;
     }
 
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    // Stateless hashers of both maps are the same, so with equal bucket
+    // counts equal keys are in buckets with equal indices
+    if(std::is_empty<Hash>::value
+       && !lhs.rehashing() && !rhs.rehashing()
+       && lhs.bucket_count() == rhs.bucket_count())
+    {
+        return lhs.equalBuckets(rhs);
+    }
+
+    return std::all_of(lhs.begin(), lhs.end(),
+                       [&rhs](const auto& item)
+                       {
+                           const auto pos = rhs.find(ValueTraits::key(item));
+                           return (pos != rhs.end())
+                               && ValueTraits::equalMapped(item, *pos);
+                       });
 }
 
 template<typename Key,
-         typename T,
+         typename ValueTraits,
          typename Hash,
-         typename KeyEqual>
-bool operator!=(const HashMap<Key, T, Hash, KeyEqual>& lhs,
-                const HashMap<Key, T, Hash, KeyEqual>& rhs)
+         typename KeyEqual,
+         typename BucketPolicy>
+bool operator!=(const HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>& lhs,
+                const HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>& rhs)
 {
     return !(lhs == rhs);
 }
 
 template<typename Key,
-         typename T,
+         typename ValueTraits,
          typename Hash,
-         typename KeyEqual>
-class HashMap<Key, T, Hash, KeyEqual>::ConstIterator
+         typename KeyEqual,
+         typename BucketPolicy>
+class HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>::ConstIterator
 {
-    friend class HashMap;
+    friend class HashTable;
 
 public:
     using iterator_category = std::bidirectional_iterator_tag;
-    using value_type = typename HashMap::value_type;
-    using difference_type = typename HashMap::difference_type;
-    using pointer = typename HashMap::const_pointer;
-    using reference = typename HashMap::const_reference;
-
-    ConstIterator(BucketIterator bucketPos,
-                  NodeIterator nodePos,
-                  const HashMap& hashMap)
-        :   bucketPos_(bucketPos)
-        ,   nodePos_(nodePos)
-        ,   hashMap_(hashMap)
+    using value_type = typename HashTable::value_type;
+    using difference_type = typename HashTable::difference_type;
+    using pointer = typename HashTable::const_pointer;
+    using reference = typename HashTable::const_reference;
+
+    ConstIterator() = default;
+
+    explicit ConstIterator(NodeIterator nodePos)
+        :   nodePos_(nodePos)
     {}
 
     reference operator*() const
@@ -460,13 +1263,6 @@ public:
 
     ConstIterator& operator--()
     {
-        while(nodePos_ == bucketPos_->begin())
-        {
-            Expects(bucketPos_ != hashMap_.hashTable_.begin());
-            --bucketPos_;
-            nodePos_ = bucketPos_->end();
-        }
-
         --nodePos_;
         return *this;
     }
@@ -480,18 +1276,7 @@ public:
 
     ConstIterator& operator++()
     {
-        Expects(bucketPos_ != std::prev(hashMap_.hashTable_.end()));
-        Expects(nodePos_ != bucketPos_->end());
-
         ++nodePos_;
-        const auto lastBucketPos = std::prev(hashMap_.hashTable_.end());
-        while((nodePos_ == bucketPos_->end())
-            && (bucketPos_ != lastBucketPos))
-        {
-            ++bucketPos_;
-            nodePos_ = bucketPos_->begin();
-        }
-
         return *this;
     }
 
@@ -504,7 +1289,7 @@ public:
 
     bool operator==(const ConstIterator& rhs) const
     {
-        return (bucketPos_ == rhs.bucketPos_ && nodePos_ == rhs.nodePos_);
+        return (nodePos_ == rhs.nodePos_);
     }
 
     bool operator!=(const ConstIterator& rhs) const
@@ -513,30 +1298,29 @@ public:
     }
 
 private:
-    BucketIterator bucketPos_;
     NodeIterator nodePos_;
-    const HashMap& hashMap_;
 };
 
 template<typename Key,
-         typename T,
+         typename ValueTraits,
          typename Hash,
-         typename KeyEqual>
-class HashMap<Key, T, Hash, KeyEqual>::Iterator
+         typename KeyEqual,
+         typename BucketPolicy>
+class HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>::Iterator
     :   public ConstIterator
 {
-    friend class HashMap;
+    friend class HashTable;
 
 public:
-    using reference = typename HashMap::reference;
-    using pointer = typename HashMap::pointer;
-    using const_reference = typename HashMap::const_reference;
-    using const_pointer = typename HashMap::const_pointer;
-
-    Iterator(BucketIterator bucketPos,
-             NodeIterator nodePos,
-             const HashMap& hashMap)
-        :   ConstIterator(bucketPos, nodePos, hashMap)
+    using reference = typename HashTable::reference;
+    using pointer = typename HashTable::pointer;
+    using const_reference = typename HashTable::const_reference;
+    using const_pointer = typename HashTable::const_pointer;
+
+    Iterator() = default;
+
+    explicit Iterator(NodeIterator nodePos)
+        :   ConstIterator(nodePos)
     {}
 
     reference operator*() const
@@ -576,4 +1360,187 @@ public:
     }
 };
 
+// Owns a node extracted from a table, until it is inserted into one
+template<typename Key,
+         typename ValueTraits,
+         typename Hash,
+         typename KeyEqual,
+         typename BucketPolicy>
+class HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>::NodeHandle
+{
+    friend class HashTable;
+
+public:
+    using key_type = typename HashTable::key_type;
+    using value_type = typename HashTable::value_type;
+
+    NodeHandle() = default;
+    NodeHandle(NodeHandle&&) = default;
+    NodeHandle& operator=(NodeHandle&&) = default;
+
+    NodeHandle(const NodeHandle&) = delete;
+    NodeHandle& operator=(const NodeHandle&) = delete;
+
+    bool empty() const noexcept
+    {
+        return nodes_.empty();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return !empty();
+    }
+
+    const key_type& key() const
+    {
+        Expects(!empty());
+        return nodes_.begin()->key();
+    }
+
+    typename HashTable::reference value() const
+    {
+        Expects(!empty());
+        return const_cast<Nodes&>(nodes_).begin()->value;
+    }
+
+    // Available for maps only
+    auto& mapped() const
+    {
+        return value().second;
+    }
+
+private:
+    // NOTE: List keeps its sentinels inline, so moving a node in
+    //  and out of it does not allocate
+    Nodes nodes_;
+};
+
+template<typename Key,
+         typename ValueTraits,
+         typename Hash,
+         typename KeyEqual,
+         typename BucketPolicy>
+struct HashTable<Key, ValueTraits, Hash, KeyEqual, BucketPolicy>::InsertReturnType
+{
+    iterator position;
+    bool inserted;
+    node_type node;
+};
+
+} // namespace detail
+
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = ModuloBucketPolicy>
+class HashMap
+    :   public detail::HashTable<Key, detail::MapValueTraits<Key, T>,
+                                 Hash, KeyEqual, BucketPolicy>
+{
+    using Base = detail::HashTable<Key, detail::MapValueTraits<Key, T>,
+                                   Hash, KeyEqual, BucketPolicy>;
+
+    template<typename K>
+    using EnableIfTransparent = typename Base::template EnableIfTransparent<K>;
+
+public:
+    using mapped_type = T;
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::iterator;
+
+    explicit HashMap(size_type bucketCount = Base::DefaultBucketCount)
+        :   Base(bucketCount)
+    {}
+
+    HashMap(size_type bucketCount,
+            const Hash& hash,
+            const KeyEqual& equal = KeyEqual())
+        :   Base(bucketCount, hash, equal)
+    {}
+
+    template<typename InputIt>
+    HashMap(InputIt first, InputIt last,
+            size_type bucketCount = Base::DefaultBucketCount)
+        :   HashMap(bucketCount)
+    {
+        std::for_each(first, last,
+                      [this](const auto& value)
+                      {
+                          const auto& key = value.first;
+                          const auto& mapped = value.second;
+                          this->operator[](key) = mapped;
+                      });
+    }
+
+    HashMap(std::initializer_list<value_type> init,
+            size_type bucketCount = Base::DefaultBucketCount)
+        :   HashMap(init.begin(), init.end(), bucketCount)
+    {}
+
+    T& at(const key_type& key)
+    {
+        return mappedAt(key);
+    }
+
+    const T& at(const key_type& key) const
+    {
+        return const_cast<HashMap&>(*this).mappedAt(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    T& at(const K& key)
+    {
+        return mappedAt(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    const T& at(const K& key) const
+    {
+        return const_cast<HashMap&>(*this).mappedAt(key);
+    }
+
+    T& operator[](const key_type& key)
+    {
+        const auto result = this->emplaceKey(key,
+                                             std::piecewise_construct,
+                                             std::forward_as_tuple(key),
+                                             std::forward_as_tuple());
+        const auto pos = result.first;
+        auto& mapped = pos->second;
+        return mapped;
+    }
+
+    template<class M>
+    iterator insert_or_assign(const key_type& key, M&& obj)
+    {
+        const auto result = this->emplaceKey(key,
+                                             std::piecewise_construct,
+                                             std::forward_as_tuple(key),
+                                             std::forward_as_tuple(std::forward<M>(obj)));
+        const auto pos = result.first;
+        if(!result.second)
+        {
+            pos->second = std::forward<M>(obj);
+        }
+
+        return pos;
+    }
+
+private:
+    template<typename K>
+    T& mappedAt(const K& key)
+    {
+        auto pos = this->findKey(key);
+        if(pos == this->end())
+        {
+            throw std::out_of_range("Key not exist");
+        }
+
+        return pos->second;
+    }
+};
+
 } // namespace aisdi
@@ -0,0 +1,70 @@
+#ifndef AISDI_HASHSET_HPP
+#define AISDI_HASHSET_HPP
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/HashMap.hpp"
+#include "aisdi/ValueTraits.hpp"
+
+namespace aisdi {
+
+// Hash set sharing the table of HashMap. Nodes keep bare keys, and
+// insert() tells whether the key was new, so "visit once" checks need
+// a single lookup instead of contains() followed by an insertion.
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = ModuloBucketPolicy>
+class HashSet
+    :   public detail::HashTable<Key, detail::SetValueTraits<Key>,
+                                 Hash, KeyEqual, BucketPolicy>
+{
+    using Base = detail::HashTable<Key, detail::SetValueTraits<Key>,
+                                   Hash, KeyEqual, BucketPolicy>;
+
+public:
+    using typename Base::value_type;
+    using typename Base::size_type;
+
+    explicit HashSet(size_type bucketCount = Base::DefaultBucketCount)
+        :   Base(bucketCount)
+    {}
+
+    HashSet(size_type bucketCount,
+            const Hash& hash,
+            const KeyEqual& equal = KeyEqual())
+        :   Base(bucketCount, hash, equal)
+    {}
+
+    template<typename InputIt>
+    HashSet(InputIt first, InputIt last,
+            size_type bucketCount = Base::DefaultBucketCount)
+        :   HashSet(bucketCount)
+    {
+        insert(first, last);
+    }
+
+    HashSet(std::initializer_list<value_type> init,
+            size_type bucketCount = Base::DefaultBucketCount)
+        :   HashSet(init.begin(), init.end(), bucketCount)
+    {}
+
+    using Base::insert;
+
+    template<typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        std::for_each(first, last,
+                      [this](const auto& key)
+                      {
+                          this->insert(key);
+                      });
+    }
+};
+
+} // namespace aisdi
+
+#endif
@@ -0,0 +1,849 @@
+#ifndef AISDI_INTEGERHASHMAP_HPP
+#define AISDI_INTEGERHASHMAP_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <gsl/gsl_assert>
+
+#include "aisdi/AlignedStorage.hpp"
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/simd.hpp"
+#include "aisdi/util.hpp"
+
+namespace aisdi {
+
+// Open addressing hash map of integer keys (e.g. 32-bit descriptors),
+// with keys and values kept in two parallel arrays.
+//
+// Keys are stored in a flat array, in which the largest value of Key marks
+// a free slot. The array is split into groups of one cache line (16 keys
+// of 32 bits), which are compared with the looked up key at once with SIMD
+// instructions. A lookup starts in the group chosen by Fibonacci hashing
+// and goes on to the next group only when some key has overflowed from
+// the current one, so probing reads only key memory: a value is touched
+// once its key is found. The key equal to the sentinel is kept aside.
+//
+// Every group counts keys, which were placed past it because it was full.
+// Erasing a key decrements counts on its probe path and frees its slot
+// without leaving a tombstone, so erasures do not lengthen later lookups.
+//
+// NOTE: Unlike in HashMap, growing the table moves all items, so insertion
+//  may invalidate iterators and references. Erasing does not move anything.
+//  Iterators yield pair-like proxies, which refer to key and value kept in
+//  separate arrays, so operator* returns them by value.
+template<typename Key, typename T>
+class IntegerHashMap
+{
+    static_assert(std::is_integral<Key>::value && simd::IsVectorizable<Key>::value,
+                  "Keys have to be integers of a vectorizable size");
+
+public:
+    template<typename Mapped>
+    struct ItemReference;
+
+    template<typename Mapped>
+    struct ItemPointer;
+
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = ItemReference<T>;
+    using const_reference = ItemReference<const T>;
+    using pointer = ItemPointer<T>;
+    using const_pointer = ItemPointer<const T>;
+
+    class ConstIterator;
+    class Iterator;
+
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    // Pair-like view of an item, so iterators may be used as those of HashMap
+    template<typename Mapped>
+    struct ItemReference
+    {
+        const key_type& first;
+        Mapped& second;
+
+        operator std::pair<const key_type, std::remove_const_t<Mapped>>() const
+        {
+            return {first, second};
+        }
+    };
+
+    // Result of operator->, which keeps the proxy alive for member access
+    template<typename Mapped>
+    struct ItemPointer
+    {
+        ItemReference<Mapped> item;
+
+        const ItemReference<Mapped>* operator->() const noexcept
+        {
+            return std::addressof(item);
+        }
+    };
+
+private:
+    constexpr static size_type CacheLineSize = 64;
+    constexpr static size_type GroupSize = CacheLineSize / sizeof(Key);
+    constexpr static float DefaultMaxLoadFactor = 0.875f;
+    constexpr static std::uint8_t MaxOverflow = std::numeric_limits<std::uint8_t>::max();
+    constexpr static key_type EmptyKey = std::numeric_limits<key_type>::max();
+
+    using Keys = AlignedStorage<key_type, CacheLineSize>;
+    using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    // Table is allocated by the first insertion, unless a count of slots is given
+    explicit IntegerHashMap(size_type bucketCount = 0)
+    {
+        if(bucketCount > 0)
+        {
+            init(bucketCount);
+        }
+    }
+
+    template<typename InputIt>
+    IntegerHashMap(InputIt first, InputIt last, size_type bucketCount = 0)
+        :   IntegerHashMap(bucketCount)
+    {
+        std::for_each(first, last,
+                      [this](const auto& value)
+                      {
+                          const auto& key = value.first;
+                          const auto& mapped = value.second;
+                          this->operator[](key) = mapped;
+                      });
+    }
+
+    IntegerHashMap(std::initializer_list<value_type> init, size_type bucketCount = 0)
+        :   IntegerHashMap(init.begin(), init.end(), bucketCount)
+    {}
+
+    // Items keep their slots, since both maps hash keys the same way
+    IntegerHashMap(const IntegerHashMap& other)
+        :   maxLoadFactor_(other.maxLoadFactor_)
+    {
+        if(other.groupCount_ == 0)
+        {
+            return;
+        }
+
+        init(other.slotCount_);
+        std::copy(other.overflows_.get(), other.overflows_.get() + groupCount_, overflows_.get());
+        try
+        {
+            for(auto slot = other.nextSlot(0); slot != other.endSlot(); slot = other.nextSlot(slot + 1))
+            {
+                construct(slot, other.keyAt(slot), other.valueAt(slot));
+            }
+        }
+        catch(...)
+        {
+            destroyItems();
+            throw;
+        }
+
+        Ensures(size_ == other.size_);
+    }
+
+    IntegerHashMap(IntegerHashMap&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    ~IntegerHashMap()
+    {
+        destroyItems();
+    }
+
+    IntegerHashMap& operator=(const IntegerHashMap& other)
+    {
+        if(&other != this)
+        {
+            auto copy = other;
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    // Moved from map has no table, until an item is inserted into it
+    IntegerHashMap& operator=(IntegerHashMap&& other) noexcept
+    {
+        if(&other != this)
+        {
+            destroyItems();
+
+            keys_ = std::move(other.keys_);
+            values_ = std::move(other.values_);
+            overflows_ = std::move(other.overflows_);
+            policy_ = other.policy_;
+            groupCount_ = other.groupCount_;
+            slotCount_ = other.slotCount_;
+            size_ = other.size_;
+            hasEmptyKey_ = other.hasEmptyKey_;
+            maxLoadFactor_ = other.maxLoadFactor_;
+
+            other.groupCount_ = 0;
+            other.slotCount_ = 0;
+            other.size_ = 0;
+            other.hasEmptyKey_ = false;
+        }
+
+        return *this;
+    }
+
+    iterator begin()
+    {
+        return iterator{this, nextSlot(0)};
+    }
+
+    const_iterator begin() const
+    {
+        return const_cast<IntegerHashMap&>(*this).begin();
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    iterator end()
+    {
+        return iterator{this, endSlot()};
+    }
+
+    const_iterator end() const
+    {
+        return const_cast<IntegerHashMap&>(*this).end();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    // Returns position of the item with key of value and whether it was
+    // inserted, so a key is both checked and added with a single lookup
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return emplaceKey(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return emplaceKey(value.first, std::move(value.second));
+    }
+
+    T& operator[](key_type key)
+    {
+        const auto result = emplaceKey(key);
+        return valueAt(result.first.slot_);
+    }
+
+    template<class M>
+    iterator insert_or_assign(key_type key, M&& obj)
+    {
+        const auto result = emplaceKey(key, std::forward<M>(obj));
+        if(!result.second)
+        {
+            valueAt(result.first.slot_) = std::forward<M>(obj);
+        }
+
+        return result.first;
+    }
+
+    T& at(key_type key)
+    {
+        const auto slot = locate(key);
+        if(slot == endSlot())
+        {
+            throw std::out_of_range("Key not exist");
+        }
+
+        return valueAt(slot);
+    }
+
+    const T& at(key_type key) const
+    {
+        return const_cast<IntegerHashMap&>(*this).at(key);
+    }
+
+    // Frees the slot without moving other items, so only iterators
+    // to the erased item are invalidated
+    iterator erase(const const_iterator& pos)
+    {
+        Expects(pos != end());
+
+        const auto slot = pos.slot_;
+        destroy(slot);
+        return iterator{this, nextSlot(slot + 1)};
+    }
+
+    size_type erase(key_type key)
+    {
+        const auto slot = locate(key);
+        if(slot == endSlot())
+        {
+            return 0;
+        }
+
+        destroy(slot);
+        return 1;
+    }
+
+    bool contains(key_type key) const noexcept
+    {
+        return (locate(key) != endSlot());
+    }
+
+    size_type count(key_type key) const noexcept
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    iterator find(key_type key)
+    {
+        return iterator{this, locate(key)};
+    }
+
+    const_iterator find(key_type key) const
+    {
+        return const_cast<IntegerHashMap&>(*this).find(key);
+    }
+
+    // Every slot is a bucket, so the load factor is the fraction of
+    // occupied slots (not counting the key equal to the sentinel)
+    float load_factor() const
+    {
+        Expects(bucket_count() > 0);
+        return (static_cast<float>(tableSize()) / static_cast<float>(bucket_count()));
+    }
+
+    float max_load_factor() const noexcept
+    {
+        return maxLoadFactor_;
+    }
+
+    void max_load_factor(float maxLoadFactor)
+    {
+        Expects(maxLoadFactor > 0.0f && maxLoadFactor <= 1.0f);
+        maxLoadFactor_ = maxLoadFactor;
+    }
+
+    // Moves items into at least bucketCount slots (and at least as many as
+    // max_load_factor() requires). Slots come in a power of two groups of
+    // one cache line each. Invalidates iterators and references.
+    void rehash(size_type bucketCount)
+    {
+        const auto minBucketCount = static_cast<size_type>(
+            std::ceil(static_cast<float>(tableSize()) / maxLoadFactor_));
+        bucketCount = slotCountFor(std::max(bucketCount, minBucketCount));
+        if(bucketCount == bucket_count())
+        {
+            return;
+        }
+
+        // Values are copied, unless they may be moved without throwing,
+        // so failed rehash leaves the map intact
+        auto table = IntegerHashMap(bucketCount);
+        table.maxLoadFactor_ = maxLoadFactor_;
+        for(auto slot = nextSlot(0); slot != endSlot(); slot = nextSlot(slot + 1))
+        {
+            table.emplaceNew(keyAt(slot), std::move_if_noexcept(valueAt(slot)));
+        }
+
+        *this = std::move(table);
+
+        Ensures(bucket_count() >= bucketCount);
+    }
+
+    // Prepares map for count items without exceeding max_load_factor()
+    void reserve(size_type count)
+    {
+        rehash(static_cast<size_type>(std::ceil(static_cast<float>(count) / maxLoadFactor_)));
+    }
+
+    size_type bucket_count() const noexcept
+    {
+        return slotCount_;
+    }
+
+    bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    void clear() noexcept
+    {
+        destroyItems();
+        std::fill(overflows_.get(), overflows_.get() + groupCount_, std::uint8_t{0});
+
+        Ensures(empty());
+    }
+
+private:
+    static size_type slotCountFor(size_type bucketCount) noexcept
+    {
+        const auto groupCount = (bucketCount + GroupSize - 1) / GroupSize;
+        return FibonacciBucketPolicy::bucketCount(groupCount) * GroupSize;
+    }
+
+    void init(size_type bucketCount)
+    {
+        const auto slotCount = slotCountFor(bucketCount);
+        const auto groupCount = slotCount / GroupSize;
+
+        // One more slot is kept after the groups for the key equal to the sentinel
+        auto keys = Keys(slotCount + 1);
+        std::fill(keys.data(), keys.data() + keys.capacity(), EmptyKey);
+        values_.reset(new Slot[slotCount + 1]);
+        overflows_.reset(new std::uint8_t[groupCount]());
+        keys_ = std::move(keys);
+
+        policy_.reset(groupCount);
+        groupCount_ = groupCount;
+        slotCount_ = slotCount;
+        size_ = 0;
+        hasEmptyKey_ = false;
+
+        Ensures(empty());
+    }
+
+    // Number of items kept in groups
+    size_type tableSize() const noexcept
+    {
+        return hasEmptyKey_ ? (size_ - 1) : size_;
+    }
+
+    size_type endSlot() const noexcept
+    {
+        return (groupCount_ > 0) ? (slotCount_ + 1) : 0;
+    }
+
+    size_type emptyKeySlot() const noexcept
+    {
+        return slotCount_;
+    }
+
+    size_type groupOf(key_type key) const noexcept
+    {
+        return policy_.index(static_cast<std::size_t>(key));
+    }
+
+    size_type nextGroup(size_type group) const noexcept
+    {
+        return (group + 1) & (groupCount_ - 1);
+    }
+
+    const key_type* groupKeys(size_type group) const noexcept
+    {
+        return keys_.data() + group * GroupSize;
+    }
+
+    const key_type& keyAt(size_type slot) const noexcept
+    {
+        return keys_.data()[slot];
+    }
+
+    T& valueAt(size_type slot) noexcept
+    {
+        return *reinterpret_cast<T*>(&values_[slot]);
+    }
+
+    const T& valueAt(size_type slot) const noexcept
+    {
+        return const_cast<IntegerHashMap&>(*this).valueAt(slot);
+    }
+
+    bool isOccupied(size_type slot) const noexcept
+    {
+        return (slot < slotCount_) ? (keyAt(slot) != EmptyKey) : hasEmptyKey_;
+    }
+
+    // Returns the first occupied slot not before slot, or endSlot()
+    size_type nextSlot(size_type slot) const noexcept
+    {
+        while(slot < endSlot() && !isOccupied(slot))
+        {
+            ++slot;
+        }
+
+        return slot;
+    }
+
+    // Returns the last occupied slot before slot
+    size_type previousSlot(size_type slot) const noexcept
+    {
+        do
+        {
+            --slot;
+        }
+        while(!isOccupied(slot));
+
+        return slot;
+    }
+
+    // Returns slot of the key, or endSlot(), if key is missing.
+    // Only keys are read: every group is compared with the key as a whole.
+    size_type locate(key_type key) const noexcept
+    {
+        if(empty())
+        {
+            return endSlot();
+        }
+
+        if(key == EmptyKey)
+        {
+            return hasEmptyKey_ ? emptyKeySlot() : endSlot();
+        }
+
+        auto group = groupOf(key);
+        for(auto probes = size_type{0}; probes < groupCount_; ++probes)
+        {
+            const auto first = groupKeys(group);
+            const auto last = first + GroupSize;
+            const auto pos = simd::find(first, last, key);
+            if(pos != last)
+            {
+                return static_cast<size_type>(pos - keys_.data());
+            }
+
+            if(overflows_[group] == 0)
+            {
+                break;
+            }
+
+            group = nextGroup(group);
+        }
+
+        return endSlot();
+    }
+
+    // Returns the first free slot in probe sequence of the key
+    size_type freeSlotFor(key_type key) const noexcept
+    {
+        auto group = groupOf(key);
+        while(true)
+        {
+            const auto first = groupKeys(group);
+            const auto last = first + GroupSize;
+            const auto pos = simd::find(first, last, EmptyKey);
+            if(pos != last)
+            {
+                return static_cast<size_type>(pos - keys_.data());
+            }
+
+            group = nextGroup(group);
+        }
+    }
+
+    // Returns position of the key, or of a new item with value constructed
+    // of args, if key is missing. Args are not used, when key is present.
+    template<typename... Args>
+    std::pair<iterator, bool> emplaceKey(key_type key, Args&&... args)
+    {
+        const auto slot = locate(key);
+        if(slot != endSlot())
+        {
+            return {iterator{this, slot}, false};
+        }
+
+        if(key != EmptyKey)
+        {
+            const auto maxSize = static_cast<float>(bucket_count()) * maxLoadFactor_;
+            if(static_cast<float>(tableSize() + 1) > maxSize)
+            {
+                grow();
+            }
+        }
+        else if(groupCount_ == 0)
+        {
+            grow();
+        }
+
+        const auto newSlot = emplaceNew(key, std::forward<Args>(args)...);
+        return {iterator{this, newSlot}, true};
+    }
+
+    // Constructs an item of a missing key in a table with a free slot for it.
+    // Overflow counts of groups skipped on the way are raised only after
+    // the value is constructed, so an exception leaves the table unchanged.
+    template<typename... Args>
+    size_type emplaceNew(key_type key, Args&&... args)
+    {
+        if(key == EmptyKey)
+        {
+            construct(emptyKeySlot(), key, std::forward<Args>(args)...);
+            return emptyKeySlot();
+        }
+
+        const auto slot = freeSlotFor(key);
+        construct(slot, key, std::forward<Args>(args)...);
+
+        const auto home = groupOf(key);
+        for(auto group = home; group != slot / GroupSize; group = nextGroup(group))
+        {
+            if(overflows_[group] != MaxOverflow)
+            {
+                ++overflows_[group];
+            }
+        }
+
+        return slot;
+    }
+
+    template<typename... Args>
+    void construct(size_type slot, key_type key, Args&&... args)
+    {
+        Expects(!isOccupied(slot));
+
+        new (&values_[slot]) T(std::forward<Args>(args)...);
+        if(slot == emptyKeySlot())
+        {
+            hasEmptyKey_ = true;
+        }
+        else
+        {
+            keys_.data()[slot] = key;
+        }
+
+        ++size_;
+    }
+
+    // Saturated counts are never lowered, since they lost track of keys
+    void destroy(size_type slot) noexcept
+    {
+        util::destroy_at(&valueAt(slot));
+        --size_;
+        if(slot == emptyKeySlot())
+        {
+            hasEmptyKey_ = false;
+            return;
+        }
+
+        const auto home = groupOf(keyAt(slot));
+        for(auto group = home; group != slot / GroupSize; group = nextGroup(group))
+        {
+            if(overflows_[group] != MaxOverflow)
+            {
+                --overflows_[group];
+            }
+        }
+
+        keys_.data()[slot] = EmptyKey;
+    }
+
+    void grow()
+    {
+        rehash(std::max(bucket_count() * 2, GroupSize));
+    }
+
+    void destroyItems() noexcept
+    {
+        for(auto slot = nextSlot(0); slot != endSlot(); slot = nextSlot(slot + 1))
+        {
+            destroy(slot);
+        }
+
+        Ensures(size_ == 0);
+    }
+
+    Keys keys_;
+    std::unique_ptr<Slot[]> values_;
+    std::unique_ptr<std::uint8_t[]> overflows_;
+    FibonacciBucketPolicy policy_;
+    size_type groupCount_ = 0;
+    size_type slotCount_ = 0;
+    size_type size_ = 0;
+    bool hasEmptyKey_ = false;
+    float maxLoadFactor_ = DefaultMaxLoadFactor;
+};
+
+template<typename Key, typename T>
+constexpr std::size_t IntegerHashMap<Key, T>::GroupSize;
+
+template<typename Key, typename T>
+constexpr Key IntegerHashMap<Key, T>::EmptyKey;
+
+// NOTE: Slots of equal keys depend on history of the maps,
+//  so items are looked up in the other map instead. O(size) expected.
+template<typename Key, typename T>
+bool operator==(const IntegerHashMap<Key, T>& lhs, const IntegerHashMap<Key, T>& rhs)
+{
+    if(&lhs == &rhs)
+    {
+        return true;
+    }
+
+    if(lhs.size() != rhs.size())
+    {
+        return false;
+    }
+
+    return std::all_of(lhs.begin(), lhs.end(),
+                       [&rhs](const auto& item)
+                       {
+                           const auto pos = rhs.find(item.first);
+                           return (pos != rhs.end()) && (pos->second == item.second);
+                       });
+}
+
+template<typename Key, typename T>
+bool operator!=(const IntegerHashMap<Key, T>& lhs, const IntegerHashMap<Key, T>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template<typename Key, typename T>
+class IntegerHashMap<Key, T>::ConstIterator
+{
+    friend class IntegerHashMap;
+
+public:
+    // Proxies are returned by value, yet items are not moved by traversal
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename IntegerHashMap::value_type;
+    using difference_type = typename IntegerHashMap::difference_type;
+    using pointer = typename IntegerHashMap::const_pointer;
+    using reference = typename IntegerHashMap::const_reference;
+
+    ConstIterator() = default;
+
+    ConstIterator(IntegerHashMap* map, size_type slot)
+        :   map_(map)
+        ,   slot_(slot)
+    {}
+
+    reference operator*() const
+    {
+        Expects(map_ && slot_ < map_->endSlot());
+        return {map_->keyAt(slot_), map_->valueAt(slot_)};
+    }
+
+    pointer operator->() const
+    {
+        return {operator*()};
+    }
+
+    ConstIterator& operator--()
+    {
+        Expects(map_ && slot_ != map_->nextSlot(0));
+        slot_ = map_->previousSlot(slot_);
+        return *this;
+    }
+
+    ConstIterator operator--(int)
+    {
+        const auto result = *this;
+        operator--();
+        return result;
+    }
+
+    ConstIterator& operator++()
+    {
+        Expects(map_ && slot_ < map_->endSlot());
+        slot_ = map_->nextSlot(slot_ + 1);
+        return *this;
+    }
+
+    ConstIterator operator++(int)
+    {
+        const auto result = *this;
+        operator++();
+        return result;
+    }
+
+    bool operator==(const ConstIterator& rhs) const
+    {
+        return (map_ == rhs.map_ && slot_ == rhs.slot_);
+    }
+
+    bool operator!=(const ConstIterator& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    IntegerHashMap* map_ = nullptr;
+    size_type slot_ = 0;
+};
+
+template<typename Key, typename T>
+class IntegerHashMap<Key, T>::Iterator
+    :   public ConstIterator
+{
+    friend class IntegerHashMap;
+
+public:
+    using reference = typename IntegerHashMap::reference;
+    using pointer = typename IntegerHashMap::pointer;
+    using const_reference = typename IntegerHashMap::const_reference;
+    using const_pointer = typename IntegerHashMap::const_pointer;
+
+    Iterator() = default;
+
+    Iterator(IntegerHashMap* map, size_type slot)
+        :   ConstIterator(map, slot)
+    {}
+
+    reference operator*() const
+    {
+        const auto item = ConstIterator::operator*();
+        return {item.first, const_cast<T&>(item.second)};
+    }
+
+    pointer operator->() const
+    {
+        return {operator*()};
+    }
+
+    Iterator& operator--()
+    {
+        ConstIterator::operator--();
+        return *this;
+    }
+
+    Iterator operator--(int)
+    {
+        const auto result = *this;
+        operator--();
+        return result;
+    }
+
+    Iterator& operator++()
+    {
+        ConstIterator::operator++();
+        return *this;
+    }
+
+    Iterator operator++(int)
+    {
+        const auto result = *this;
+        operator++();
+        return result;
+    }
+};
+
+} // namespace aisdi
+
+#endif
@@ -0,0 +1,304 @@
+#ifndef AISDI_MAPPEDSTATICHASHMAP_HPP
+#define AISDI_MAPPEDSTATICHASHMAP_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gsl/gsl_assert>
+
+#include "aisdi/StaticHashMap.hpp"
+
+namespace aisdi {
+
+// Read-only view of an image written by StaticHashMap::save().
+//
+// Opening maps the file and checks its header, without reading any item,
+// so it takes constant time regardless of the map size. Lookups read
+// pilots and items straight from mapped pages, which are loaded on first
+// access and shared through page cache by all processes mapping the same
+// image, so many processes serving the same table keep a single copy
+// in memory.
+//
+// NOTE: Keys are hashed when looking them up, so the hasher has to give
+//  the same hashes as the one used to build the map (e.g. std::hash of
+//  the same build, or a seeded hasher with the same seed).
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class MappedStaticHashMap
+{
+    static_assert(std::is_trivially_copyable<Key>::value
+                  && std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable keys and values may be mapped");
+
+    using Header = detail::StaticImageHeader;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = detail::PackedItem<Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using iterator = const value_type*;
+    using const_iterator = const value_type*;
+
+    explicit MappedStaticHashMap(const std::string& path,
+                                 const Hash& hash = Hash(),
+                                 const KeyEqual& equal = KeyEqual())
+        :   hasher_(hash)
+        ,   keyEqual_(equal)
+    {
+        map(path);
+
+        try
+        {
+            checkHeader();
+        }
+        catch(...)
+        {
+            unmap();
+            throw;
+        }
+    }
+
+    MappedStaticHashMap(const MappedStaticHashMap&) = delete;
+    MappedStaticHashMap& operator=(const MappedStaticHashMap&) = delete;
+
+    // Moved from map has no mapping and behaves as an empty one
+    MappedStaticHashMap(MappedStaticHashMap&& other) noexcept
+        :   hasher_(std::move(other.hasher_))
+        ,   keyEqual_(std::move(other.keyEqual_))
+        ,   mapping_(other.mapping_)
+        ,   mappedBytes_(other.mappedBytes_)
+    {
+        other.mapping_ = nullptr;
+        other.mappedBytes_ = 0;
+    }
+
+    MappedStaticHashMap& operator=(MappedStaticHashMap&& other) noexcept
+    {
+        if(this != &other)
+        {
+            unmap();
+
+            hasher_ = std::move(other.hasher_);
+            keyEqual_ = std::move(other.keyEqual_);
+            mapping_ = other.mapping_;
+            mappedBytes_ = other.mappedBytes_;
+
+            other.mapping_ = nullptr;
+            other.mappedBytes_ = 0;
+        }
+
+        return *this;
+    }
+
+    ~MappedStaticHashMap()
+    {
+        unmap();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return mapping_ ? section<value_type>(header().itemsOffset) : nullptr;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return std::next(begin(), static_cast<difference_type>(size()));
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool empty() const noexcept
+    {
+        return (size() == 0);
+    }
+
+    size_type size() const noexcept
+    {
+        return mapping_ ? static_cast<size_type>(header().function.size) : 0;
+    }
+
+    const_iterator find(const key_type& key) const
+    {
+        if(empty())
+        {
+            return end();
+        }
+
+        const auto hash = detail::mix64(static_cast<std::uint64_t>(hasher_(key)));
+        const auto slot = header().function.slotOf(hash,
+                                                   section<detail::Pilot>(header().pilotsOffset),
+                                                   section<std::uint64_t>(header().remapOffset));
+        const auto pos = std::next(begin(), static_cast<difference_type>(slot));
+        return keyEqual_(pos->first, key) ? pos : end();
+    }
+
+    bool contains(const key_type& key) const
+    {
+        return (find(key) != end());
+    }
+
+    size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    const T& at(const key_type& key) const
+    {
+        const auto pos = find(key);
+        if(pos == end())
+        {
+            throw std::out_of_range("Key not exist");
+        }
+
+        return pos->second;
+    }
+
+    hasher hash_function() const
+    {
+        return hasher_;
+    }
+
+    key_equal key_eq() const
+    {
+        return keyEqual_;
+    }
+
+private:
+    const Header& header() const noexcept
+    {
+        return *static_cast<const Header*>(mapping_);
+    }
+
+    template<typename U>
+    const U* section(std::uint64_t offset) const noexcept
+    {
+        return reinterpret_cast<const U*>(static_cast<const char*>(mapping_) + offset);
+    }
+
+    void map(const std::string& path)
+    {
+        const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Could not open static hash map " + path);
+        }
+
+        struct stat status;
+        if(::fstat(fd, &status) != 0)
+        {
+            const auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(),
+                                    "Could not stat static hash map " + path);
+        }
+
+        const auto fileSize = static_cast<size_type>(status.st_size);
+        if(fileSize < sizeof(Header))
+        {
+            ::close(fd);
+            throw std::runtime_error("Could not open static hash map: file is truncated");
+        }
+
+        // Mapping keeps the file open by itself
+        const auto mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        const auto error = errno;
+        ::close(fd);
+        if(mapping == MAP_FAILED)
+        {
+            throw std::system_error(error, std::generic_category(),
+                                    "Could not map static hash map " + path);
+        }
+
+        mapping_ = mapping;
+        mappedBytes_ = fileSize;
+    }
+
+    void checkHeader() const
+    {
+        const auto& h = header();
+        if(std::memcmp(h.magic, Header::magicText(), sizeof(h.magic)) != 0)
+        {
+            throw std::runtime_error("Could not open static hash map: invalid magic");
+        }
+
+        if(h.version != Header::Version)
+        {
+            throw std::runtime_error("Could not open static hash map: unsupported version");
+        }
+
+        if(h.keySize != sizeof(Key) || h.valueSize != sizeof(T) || h.itemSize != sizeof(value_type))
+        {
+            throw std::runtime_error("Could not open static hash map: invalid item size");
+        }
+
+        const auto& function = h.function;
+        const auto validFunction = (function.tableSize >= function.size)
+            && (function.size == 0 || function.denseBucketCount < function.bucketCount);
+        const auto sectionsFit = (h.pilotsOffset + function.bucketCount * sizeof(detail::Pilot) <= h.remapOffset)
+            && (h.remapOffset + (function.tableSize - function.size) * sizeof(std::uint64_t) <= h.itemsOffset)
+            && (h.itemsOffset + function.size * sizeof(value_type) == h.fileSize)
+            && (h.fileSize <= mappedBytes_);
+        if(!validFunction || !sectionsFit)
+        {
+            throw std::runtime_error("Could not open static hash map: file is truncated");
+        }
+
+        // Key of any item has to be found in its own slot, otherwise
+        // hasher differs from the one used for building
+        if(!empty() && find(begin()->first) != begin())
+        {
+            throw std::runtime_error("Could not open static hash map: hasher does not match");
+        }
+    }
+
+    void unmap() noexcept
+    {
+        if(mapping_)
+        {
+            ::munmap(mapping_, mappedBytes_);
+        }
+
+        mapping_ = nullptr;
+        mappedBytes_ = 0;
+    }
+
+    hasher hasher_;
+    key_equal keyEqual_;
+    void* mapping_ = nullptr;
+    size_type mappedBytes_ = 0;
+};
+
+} // namespace aisdi
+
+#endif
@@ -0,0 +1,343 @@
+#ifndef AISDI_READMOSTLYHASHMAP_HPP
+#define AISDI_READMOSTLYHASHMAP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <gsl/gsl_assert>
+
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/EpochDomain.hpp"
+
+namespace aisdi {
+
+// Hash map for data, which is read very often and rarely modified.
+//
+// Lookups take no lock and write no shared memory: they walk buckets
+// published with atomic pointers, while holding an EpochDomain pin.
+// Nodes are immutable once published. Writers (serialized by a mutex)
+// build a new version of the modified chain, copying only nodes in front
+// of the changed one, publish it with a single atomic store and retire
+// replaced nodes, which are deleted once no reader can see them.
+// Growth publishes a whole new table the same way.
+//
+// NOTE: Writes cost an allocation per copied node, so use ConcurrentHashMap
+//  for data, which changes often.
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>,
+         typename BucketPolicy = ModuloBucketPolicy>
+class ReadMostlyHashMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+private:
+    struct Node
+    {
+        template<typename... Args>
+        explicit Node(std::size_t hash, const Node* next, Args&&... args)
+            :   hash(hash)
+            ,   next(next)
+            ,   value(std::forward<Args>(args)...)
+        {}
+
+        const std::size_t hash;
+        const Node* const next;
+        const value_type value;
+    };
+
+    struct Table
+    {
+        explicit Table(size_type bucketCount)
+            :   bucketCount(BucketPolicy::bucketCount(bucketCount))
+            ,   heads(new std::atomic<const Node*>[this->bucketCount])
+        {
+            policy.reset(this->bucketCount);
+            for(auto index = size_type{0}; index < this->bucketCount; ++index)
+            {
+                heads[index].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<const Node*>& head(std::size_t hash) const
+        {
+            return heads[policy.index(hash)];
+        }
+
+        const size_type bucketCount;
+        std::unique_ptr<std::atomic<const Node*>[]> heads;
+        BucketPolicy policy;
+    };
+
+    using WriteLock = std::lock_guard<std::mutex>;
+
+    constexpr static size_type DefaultBucketCount = 16;
+    constexpr static size_type GrowthFactor = 2;
+    constexpr static float MaxLoadFactor = 1.0f;
+
+public:
+    explicit ReadMostlyHashMap(size_type bucketCount = DefaultBucketCount)
+        :   table_(new Table(bucketCount))
+    {}
+
+    ReadMostlyHashMap(const ReadMostlyHashMap&) = delete;
+    ReadMostlyHashMap& operator=(const ReadMostlyHashMap&) = delete;
+
+    // NOTE: No reader may access the map anymore
+    ~ReadMostlyHashMap()
+    {
+        const auto table = table_.load(std::memory_order_relaxed);
+        deleteNodes(*table);
+        delete table;
+    }
+
+    // Copies value of the key, if it is present
+    bool find(const key_type& key, mapped_type& value) const
+    {
+        const auto guard = epochs_.pin();
+        const auto node = locate(key);
+        if(!node)
+        {
+            return false;
+        }
+
+        value = node->value.second;
+        return true;
+    }
+
+    bool contains(const key_type& key) const
+    {
+        const auto guard = epochs_.pin();
+        return (locate(key) != nullptr);
+    }
+
+    // Calls fn(const mapped_type&) with value of the key, while the value
+    // is guaranteed to stay alive. Returns false, if the key is missing.
+    // NOTE: fn must not access this map.
+    template<typename UnaryFunction>
+    bool visit(const key_type& key, UnaryFunction fn) const
+    {
+        const auto guard = epochs_.pin();
+        const auto node = locate(key);
+        if(!node)
+        {
+            return false;
+        }
+
+        fn(node->value.second);
+        return true;
+    }
+
+    // Returns true, if the key was inserted, false, if it was assigned
+    template<typename M>
+    bool insert_or_assign(const key_type& key, M&& obj)
+    {
+        WriteLock lock(writeMutex_);
+
+        if(static_cast<float>(size() + 1) > static_cast<float>(table().bucketCount) * MaxLoadFactor)
+        {
+            grow();
+        }
+
+        const auto hash = hasher_(key);
+        auto& head = table().head(hash);
+        const auto first = head.load(std::memory_order_relaxed);
+        const auto node = find(first, key, hash);
+        auto replacement = std::make_unique<Node>(hash, node ? node->next : first,
+                                                  std::piecewise_construct,
+                                                  std::forward_as_tuple(key),
+                                                  std::forward_as_tuple(std::forward<M>(obj)));
+        if(!node)
+        {
+            // New key is simply prepended, so no other node is copied
+            head.store(replacement.release(), std::memory_order_release);
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        const auto chain = copyChain(first, node, replacement.get());
+        replacement.release();
+        head.store(chain, std::memory_order_release);
+        retireChain(first, node);
+        return false;
+    }
+
+    size_type erase(const key_type& key)
+    {
+        WriteLock lock(writeMutex_);
+
+        const auto hash = hasher_(key);
+        auto& head = table().head(hash);
+        const auto first = head.load(std::memory_order_relaxed);
+        const auto node = find(first, key, hash);
+        if(!node)
+        {
+            return 0;
+        }
+
+        head.store(copyChain(first, node, node->next), std::memory_order_release);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        retireChain(first, node);
+        return 1;
+    }
+
+    size_type size() const noexcept
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const noexcept
+    {
+        return (size() == 0);
+    }
+
+    size_type bucket_count() const
+    {
+        const auto guard = epochs_.pin();
+        return table_.load(std::memory_order_acquire)->bucketCount;
+    }
+
+private:
+    // Called by readers, while the domain is pinned
+    const Node* locate(const key_type& key) const
+    {
+        const auto hash = hasher_(key);
+        const auto table = table_.load(std::memory_order_acquire);
+        return find(table->head(hash).load(std::memory_order_acquire), key, hash);
+    }
+
+    const Node* find(const Node* node, const key_type& key, std::size_t hash) const
+    {
+        for(; node; node = node->next)
+        {
+            if(node->hash == hash && keyEqual_(node->value.first, key))
+            {
+                return node;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Called by writers, which own the table
+    const Table& table() const
+    {
+        return *table_.load(std::memory_order_relaxed);
+    }
+
+    // Retires nodes [first, last] replaced by a new version of their chain
+    void retireChain(const Node* first, const Node* last)
+    {
+        for(auto node = first; node != last; node = node->next)
+        {
+            epochs_.retire(const_cast<Node*>(node));
+        }
+        epochs_.retire(const_cast<Node*>(last));
+        epochs_.collect();
+    }
+
+    // Copies nodes [first, last) in front of tail. Nodes behind last
+    // are shared by both versions of the chain.
+    const Node* copyChain(const Node* first, const Node* last, const Node* tail)
+    {
+        if(first == last)
+        {
+            return tail;
+        }
+
+        const auto next = copyChain(first->next, last, tail);
+        try
+        {
+            return new Node(first->hash, next, first->value);
+        }
+        catch(...)
+        {
+            for(auto node = next; node != tail;)
+            {
+                const auto copy = node;
+                node = node->next;
+                delete copy;
+            }
+
+            throw;
+        }
+    }
+
+    // Publishes a table with GrowthFactor times more buckets, filled with
+    // copies of all nodes, and retires the old one
+    void grow()
+    {
+        const auto& table = this->table();
+        auto grown = std::make_unique<Table>(table.bucketCount * GrowthFactor);
+        try
+        {
+            for(auto index = size_type{0}; index < table.bucketCount; ++index)
+            {
+                auto node = table.heads[index].load(std::memory_order_relaxed);
+                for(; node; node = node->next)
+                {
+                    auto& head = grown->head(node->hash);
+                    head.store(new Node(node->hash,
+                                        head.load(std::memory_order_relaxed),
+                                        node->value),
+                               std::memory_order_relaxed);
+                }
+            }
+        }
+        catch(...)
+        {
+            deleteNodes(*grown);
+            throw;
+        }
+
+        const auto old = table_.exchange(grown.release(), std::memory_order_acq_rel);
+        for(auto index = size_type{0}; index < old->bucketCount; ++index)
+        {
+            auto node = old->heads[index].load(std::memory_order_relaxed);
+            while(node)
+            {
+                const auto next = node->next;
+                epochs_.retire(const_cast<Node*>(node));
+                node = next;
+            }
+        }
+        epochs_.retire(old);
+        epochs_.collect();
+    }
+
+    static void deleteNodes(const Table& table) noexcept
+    {
+        for(auto index = size_type{0}; index < table.bucketCount; ++index)
+        {
+            auto node = table.heads[index].load(std::memory_order_relaxed);
+            while(node)
+            {
+                const auto next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+    std::atomic<Table*> table_;
+    std::atomic<size_type> size_{0};
+    mutable EpochDomain epochs_;
+    std::mutex writeMutex_;
+    hasher hasher_;
+    key_equal keyEqual_;
+};
+
+} // namespace aisdi
+
+#endif
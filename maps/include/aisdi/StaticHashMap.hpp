@@ -0,0 +1,638 @@
+#ifndef AISDI_STATICHASHMAP_HPP
+#define AISDI_STATICHASHMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl_assert>
+
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/Hash.hpp"
+#include "aisdi/Vector.hpp"
+
+namespace aisdi {
+
+namespace detail {
+
+// Maps hash onto [0, size) with a multiplication instead of a division
+inline std::size_t scaleHash(std::uint64_t hash, std::size_t size) noexcept
+{
+    auto high = static_cast<std::uint64_t>(size);
+    multiply128(hash, high);
+    return static_cast<std::size_t>(high);
+}
+
+using Pilot = std::uint16_t;
+
+// Minimal perfect hash function of StaticHashMap (without its pilots and
+// remap table). It holds only integers, so it is written as is into
+// images of the map.
+struct PerfectHash
+{
+    // 60% of keys go to 30% of buckets, so large buckets are placed
+    // first, while most slots are still free
+    constexpr static std::uint64_t DenseKeysThreshold = UINT64_C(0x9999999999999999);
+
+    std::uint64_t seed;
+    std::uint64_t size;
+    std::uint64_t tableSize;
+    std::uint64_t bucketCount;
+    std::uint64_t denseBucketCount;
+
+    std::size_t bucketOf(std::uint64_t hash) const noexcept
+    {
+        const auto low = (hash << 32);
+        if(hash < DenseKeysThreshold)
+        {
+            return scaleHash(low, denseBucketCount);
+        }
+
+        return denseBucketCount + scaleHash(low, bucketCount - denseBucketCount);
+    }
+
+    std::size_t positionOf(std::uint64_t hash, Pilot pilot) const noexcept
+    {
+        const auto displacement = seed + (static_cast<std::uint64_t>(pilot) * WyPrime1);
+        return scaleHash(mix64(hash ^ displacement), tableSize);
+    }
+
+    // Keys placed past the last slot are found through remap table
+    std::size_t slotOf(std::uint64_t hash,
+                       const Pilot* pilots,
+                       const std::uint64_t* remap) const noexcept
+    {
+        const auto position = positionOf(hash, pilots[bucketOf(hash)]);
+        if(position < size)
+        {
+            return position;
+        }
+
+        return static_cast<std::size_t>(remap[position - size]);
+    }
+};
+
+// Item of a map image, which (unlike std::pair) is trivially copyable
+template<typename Key, typename T>
+struct PackedItem
+{
+    Key first;
+    T second;
+};
+
+// Image of StaticHashMap starts with a header, followed by pilots, remap
+// table and packed items, each of them aligned to a cache line
+struct StaticImageHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t keySize;
+    std::uint32_t valueSize;
+    std::uint32_t itemSize;
+    PerfectHash function;
+    std::uint64_t pilotsOffset;
+    std::uint64_t remapOffset;
+    std::uint64_t itemsOffset;
+    std::uint64_t fileSize;
+    std::uint64_t reserved[4];
+
+    constexpr static std::uint32_t Version = 1;
+    constexpr static std::uint64_t Alignment = 64;
+
+    static const char* magicText() noexcept
+    {
+        return "AISDISHM";
+    }
+
+    static std::uint64_t alignUp(std::uint64_t offset) noexcept
+    {
+        return ((offset + Alignment - 1) / Alignment) * Alignment;
+    }
+};
+
+static_assert(sizeof(StaticImageHeader) == 128, "Header should keep sections aligned");
+
+} // namespace detail
+
+// Immutable hash map built at once from a range of items, e.g. a table
+// loaded at startup and then only looked up.
+//
+// Keys are placed with a minimal perfect hash function (in the style of
+// PTHash): keys are split into small buckets, and every bucket gets
+// a "pilot" number, chosen while building, which moves all its keys into
+// free slots. Items are packed in an array with no empty slots, so
+// lookup is one call of the hasher, reading pilot of the bucket, reading
+// the slot and one key comparison - there are no chains and no probing.
+// Pilots (with the remap table) take below a byte per key.
+//
+// Slots are 2% more than keys while building, so pilots of the last
+// buckets are found quickly; the few keys placed past the last item are
+// moved into the remaining holes and found through a small remap table.
+//
+// Maps of trivially copyable keys and values may be saved as an image,
+// which MappedStaticHashMap opens in constant time.
+//
+// NOTE: Distinct keys must not have equal hashes (since no pilot could
+//  separate them), otherwise constructor throws std::invalid_argument.
+// NOTE: Items are default constructed and then assigned while building.
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class StaticHashMap
+{
+    using Pilot = detail::Pilot;
+
+    // Keys per bucket on average; larger buckets take less memory for
+    // pilots, but take longer to place
+    constexpr static std::size_t BucketLoad = 3;
+
+    constexpr static std::size_t SlackDivisor = 50;
+
+    constexpr static std::size_t PilotBatch = 8;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using iterator = const value_type*;
+    using const_iterator = const value_type*;
+
+    StaticHashMap() = default;
+
+    // When a key repeats, its last item is kept (as in HashMap)
+    template<typename InputIt>
+    StaticHashMap(InputIt first, InputIt last,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual())
+        :   hasher_(hash)
+        ,   keyEqual_(equal)
+    {
+        auto items = std::vector<value_type>{};
+        reserveItems(items, first, last,
+                     typename std::iterator_traits<InputIt>::iterator_category{});
+        std::for_each(first, last,
+                      [&items](const auto& value)
+                      {
+                          items.emplace_back(value.first, value.second);
+                      });
+        build(items);
+    }
+
+    StaticHashMap(std::initializer_list<value_type> init,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual())
+        :   StaticHashMap(init.begin(), init.end(), hash, equal)
+    {}
+
+    const_iterator begin() const noexcept
+    {
+        return items_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return items_.end();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool empty() const noexcept
+    {
+        return items_.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return items_.size();
+    }
+
+    const_iterator find(const key_type& key) const
+    {
+        if(empty())
+        {
+            return end();
+        }
+
+        const auto slot = function_.slotOf(hashOf(key), pilots_.data(), remap_.data());
+        const auto pos = std::next(begin(), static_cast<difference_type>(slot));
+        return keyEqual_(pos->first, key) ? pos : end();
+    }
+
+    bool contains(const key_type& key) const
+    {
+        return (find(key) != end());
+    }
+
+    size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    const T& at(const key_type& key) const
+    {
+        const auto pos = find(key);
+        if(pos == end())
+        {
+            throw std::out_of_range("Key not exist");
+        }
+
+        return pos->second;
+    }
+
+    hasher hash_function() const
+    {
+        return hasher_;
+    }
+
+    key_equal key_eq() const
+    {
+        return keyEqual_;
+    }
+
+    // Bytes taken by the hash function (pilots and remap table), without items
+    size_type function_bytes() const noexcept
+    {
+        return (pilots_.size() * sizeof(Pilot)) + (remap_.size() * sizeof(std::uint64_t));
+    }
+
+    // Writes image of the map, which MappedStaticHashMap maps without
+    // parsing. The file is replaced with a rename, so processes opening
+    // it meanwhile see either the previous or the new image.
+    void save(const std::string& path) const
+    {
+        static_assert(std::is_trivially_copyable<Key>::value
+                      && std::is_trivially_copyable<T>::value,
+                      "Only trivially copyable keys and values may be saved");
+
+        using Header = detail::StaticImageHeader;
+        using Item = detail::PackedItem<Key, T>;
+
+        auto header = Header{};
+        std::memcpy(header.magic, Header::magicText(), sizeof(header.magic));
+        header.version = Header::Version;
+        header.keySize = sizeof(Key);
+        header.valueSize = sizeof(T);
+        header.itemSize = sizeof(Item);
+        header.function = function_;
+        header.pilotsOffset = Header::alignUp(sizeof(Header));
+        header.remapOffset = Header::alignUp(header.pilotsOffset + pilots_.size() * sizeof(Pilot));
+        header.itemsOffset = Header::alignUp(header.remapOffset + remap_.size() * sizeof(std::uint64_t));
+        header.fileSize = header.itemsOffset + size() * sizeof(Item);
+
+        const auto temporaryPath = path + ".tmp";
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        auto offset = std::uint64_t{0};
+        const auto write = [&file, &offset](const void* data, std::uint64_t bytes)
+            {
+                file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+                offset += bytes;
+            };
+        const auto pad = [&write, &offset](std::uint64_t sectionOffset)
+            {
+                const char zeros[Header::Alignment] = {};
+                write(zeros, sectionOffset - offset);
+            };
+
+        write(&header, sizeof(header));
+        pad(header.pilotsOffset);
+        write(pilots_.data(), pilots_.size() * sizeof(Pilot));
+        pad(header.remapOffset);
+        write(remap_.data(), remap_.size() * sizeof(std::uint64_t));
+        pad(header.itemsOffset);
+        for(const auto& value : items_)
+        {
+            // Padding bytes are zeroed, so images of equal maps are equal
+            Item item;
+            std::memset(&item, 0, sizeof(item));
+            item.first = value.first;
+            item.second = value.second;
+            write(&item, sizeof(item));
+        }
+
+        file.close();
+        if(!file || std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+        {
+            std::remove(temporaryPath.c_str());
+            throw std::runtime_error("Could not save static hash map " + path);
+        }
+
+        // Postconditions
+        Ensures(offset == header.fileSize);
+    }
+
+private:
+    struct HashedItem
+    {
+        std::uint64_t hash;
+        size_type index;
+    };
+
+    template<typename InputIt>
+    static void reserveItems(std::vector<value_type>&, InputIt, InputIt,
+                             std::input_iterator_tag)
+    {}
+
+    template<typename ForwardIt>
+    static void reserveItems(std::vector<value_type>& items, ForwardIt first, ForwardIt last,
+                             std::forward_iterator_tag)
+    {
+        items.reserve(static_cast<size_type>(std::distance(first, last)));
+    }
+
+    std::uint64_t hashOf(const key_type& key) const
+    {
+        // Bijection, so distinct hashes of keys stay distinct
+        return detail::mix64(static_cast<std::uint64_t>(hasher_(key)));
+    }
+
+    void build(std::vector<value_type>& items)
+    {
+        const auto bucketCount = std::max(items.size() / BucketLoad, size_type{1});
+        function_.denseBucketCount = std::max(bucketCount * 3 / 10, size_type{1});
+        function_.bucketCount = std::max(bucketCount, function_.denseBucketCount + 1);
+        pilots_.resize(function_.bucketCount);
+        std::fill(pilots_.begin(), pilots_.end(), Pilot{0});
+
+        auto bucketStarts = std::vector<size_type>{};
+        const auto keys = groupKeys(items, bucketStarts);
+        const auto buckets = orderBuckets(bucketStarts);
+
+        const auto count = keys.size();
+        function_.size = count;
+        function_.tableSize = count + (count / SlackDivisor) + 1;
+
+        auto positions = std::vector<size_type>(count);
+        auto taken = std::vector<bool>{};
+        for(function_.seed = 0;
+            !placeKeys(keys, bucketStarts, buckets, positions, taken);
+            ++function_.seed)
+        {}
+
+        remapPositions(positions, taken, count);
+
+        items_.resize(count);
+        for(auto i = size_type{0}; i < count; ++i)
+        {
+            const auto position = positions[i];
+            const auto slot = (position < count)
+                ? position
+                : static_cast<size_type>(remap_.data()[position - count]);
+            items_.data()[slot] = std::move(items[keys[i].index]);
+        }
+
+        // Postconditions
+        Ensures(items_.size() == count);
+    }
+
+    // Sorts hashes of keys by bucket (with a counting sort), so hashes of
+    // a bucket are kept together and trying pilots does not miss cache on
+    // every key. Repeated keys fall into the same bucket, where all but
+    // their last item are dropped.
+    std::vector<HashedItem> groupKeys(const std::vector<value_type>& items,
+                                      std::vector<size_type>& bucketStarts) const
+    {
+        auto hashes = std::vector<std::uint64_t>(items.size());
+        bucketStarts.assign(function_.bucketCount + 1, 0);
+        for(auto i = size_type{0}; i < items.size(); ++i)
+        {
+            hashes[i] = hashOf(items[i].first);
+            ++bucketStarts[function_.bucketOf(hashes[i]) + 1];
+        }
+
+        std::partial_sum(bucketStarts.begin(), bucketStarts.end(), bucketStarts.begin());
+        auto keys = std::vector<HashedItem>(items.size());
+        auto next = bucketStarts;
+        for(auto i = size_type{0}; i < items.size(); ++i)
+        {
+            keys[next[function_.bucketOf(hashes[i])]++] = HashedItem{hashes[i], i};
+        }
+
+        auto unique = keys.begin();
+        for(auto bucket = size_type{0}; bucket < function_.bucketCount; ++bucket)
+        {
+            const auto first = std::next(keys.begin(), static_cast<difference_type>(bucketStarts[bucket]));
+            const auto last = std::next(keys.begin(), static_cast<difference_type>(bucketStarts[bucket + 1]));
+            std::sort(first, last,
+                      [](const auto& lhs, const auto& rhs)
+                      {
+                          return (lhs.hash < rhs.hash)
+                              || (lhs.hash == rhs.hash && lhs.index > rhs.index);
+                      });
+
+            bucketStarts[bucket] = static_cast<size_type>(std::distance(keys.begin(), unique));
+            unique = std::unique_copy(first, last, unique,
+                                      [this, &items](const auto& lhs, const auto& rhs)
+                                      {
+                                          if(lhs.hash != rhs.hash)
+                                          {
+                                              return false;
+                                          }
+
+                                          if(!keyEqual_(items[lhs.index].first,
+                                                        items[rhs.index].first))
+                                          {
+                                              throw std::invalid_argument(
+                                                  "Distinct keys have equal hashes");
+                                          }
+
+                                          return true;
+                                      });
+        }
+
+        keys.erase(unique, keys.end());
+        bucketStarts.back() = keys.size();
+        return keys;
+    }
+
+    // Non-empty buckets from the largest one (with a counting sort by size)
+    std::vector<size_type> orderBuckets(const std::vector<size_type>& bucketStarts) const
+    {
+        const auto bucketSize = [&bucketStarts](size_type bucket)
+            {
+                return bucketStarts[bucket + 1] - bucketStarts[bucket];
+            };
+
+        auto maxSize = size_type{0};
+        for(auto bucket = size_type{0}; bucket < function_.bucketCount; ++bucket)
+        {
+            maxSize = std::max(maxSize, bucketSize(bucket));
+        }
+
+        auto sizeStarts = std::vector<size_type>(maxSize + 1, 0);
+        for(auto bucket = size_type{0}; bucket < function_.bucketCount; ++bucket)
+        {
+            ++sizeStarts[maxSize - bucketSize(bucket)];
+        }
+
+        // Empty buckets are counted last and left out
+        const auto nonEmpty = function_.bucketCount - sizeStarts[maxSize];
+        std::partial_sum(sizeStarts.begin(), sizeStarts.end(), sizeStarts.begin());
+        std::rotate(sizeStarts.begin(), std::prev(sizeStarts.end()), sizeStarts.end());
+        sizeStarts.front() = 0;
+
+        auto buckets = std::vector<size_type>(function_.bucketCount);
+        for(auto bucket = size_type{0}; bucket < function_.bucketCount; ++bucket)
+        {
+            buckets[sizeStarts[maxSize - bucketSize(bucket)]++] = bucket;
+        }
+
+        buckets.resize(nonEmpty);
+        return buckets;
+    }
+
+    // Finds pilots of all buckets, largest ones first. Fails when some
+    // bucket needs a pilot out of range, then it is retried with next seed.
+    bool placeKeys(const std::vector<HashedItem>& keys,
+                   const std::vector<size_type>& bucketStarts,
+                   const std::vector<size_type>& buckets,
+                   std::vector<size_type>& positions,
+                   std::vector<bool>& taken)
+    {
+        taken.assign(function_.tableSize, false);
+        for(auto bucket : buckets)
+        {
+            const auto first = bucketStarts[bucket];
+            const auto last = bucketStarts[bucket + 1];
+            if(!placeBucket(bucket, keys, first, last, positions, taken))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool placeBucket(size_type bucket,
+                     const std::vector<HashedItem>& keys,
+                     size_type first,
+                     size_type last,
+                     std::vector<size_type>& positions,
+                     std::vector<bool>& taken)
+    {
+        constexpr auto PilotCount = size_type{std::numeric_limits<Pilot>::max()} + 1;
+
+        for(auto batch = size_type{0}; batch < PilotCount; batch += PilotBatch)
+        {
+            // Most pilots are rejected by the first key, so it is checked
+            // for a few pilots at once and their cache misses overlap
+            bool free[PilotBatch];
+            for(auto i = size_type{0}; i < PilotBatch; ++i)
+            {
+                const auto pilot = static_cast<Pilot>(batch + i);
+                free[i] = !taken[function_.positionOf(keys[first].hash, pilot)];
+            }
+
+            for(auto i = size_type{0}; i < PilotBatch; ++i)
+            {
+                const auto pilot = static_cast<Pilot>(batch + i);
+                if(free[i] && tryPilot(pilot, keys, first, last, positions, taken))
+                {
+                    pilots_.data()[bucket] = pilot;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool tryPilot(Pilot pilot,
+                  const std::vector<HashedItem>& keys,
+                  size_type first,
+                  size_type last,
+                  std::vector<size_type>& positions,
+                  std::vector<bool>& taken) const
+    {
+        auto placed = first;
+        for(; placed != last; ++placed)
+        {
+            const auto position = function_.positionOf(keys[placed].hash, pilot);
+            if(taken[position])
+            {
+                break;
+            }
+
+            taken[position] = true;
+            positions[placed] = position;
+        }
+
+        if(placed == last)
+        {
+            return true;
+        }
+
+        for(auto i = first; i != placed; ++i)
+        {
+            taken[positions[i]] = false;
+        }
+
+        return false;
+    }
+
+    // Keys placed past the last slot are moved into holes before it
+    void remapPositions(const std::vector<size_type>& positions,
+                        const std::vector<bool>& taken,
+                        size_type count)
+    {
+        auto holes = std::vector<size_type>{};
+        for(auto i = size_type{0}; i < count; ++i)
+        {
+            if(!taken[i])
+            {
+                holes.push_back(i);
+            }
+        }
+
+        remap_.resize(function_.tableSize - count);
+        std::fill(remap_.begin(), remap_.end(), std::uint64_t{0});
+        auto hole = holes.begin();
+        for(auto position : positions)
+        {
+            if(position >= count)
+            {
+                remap_.data()[position - count] = *hole++;
+            }
+        }
+
+        Ensures(hole == holes.end());
+    }
+
+    hasher hasher_;
+    key_equal keyEqual_;
+    detail::PerfectHash function_{};
+    Vector<Pilot> pilots_;
+    Vector<std::uint64_t> remap_;
+    Vector<value_type> items_;
+};
+
+} // namespace aisdi
+
+#endif
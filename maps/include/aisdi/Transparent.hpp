@@ -0,0 +1,31 @@
+#ifndef AISDI_TRANSPARENT_HPP
+#define AISDI_TRANSPARENT_HPP
+
+#include <type_traits>
+
+namespace aisdi {
+namespace detail {
+
+template<typename...>
+struct MakeVoid
+{
+    using type = void;
+};
+
+// Tells whether function object accepts arguments of any compatible type
+// (std::less<>, std::equal_to<>, ...), so maps may look up keys without
+// constructing key_type first
+template<typename T, typename = void>
+struct IsTransparent
+    :   std::false_type
+{};
+
+template<typename T>
+struct IsTransparent<T, typename MakeVoid<typename T::is_transparent>::type>
+    :   std::true_type
+{};
+
+} // namespace detail
+} // namespace aisdi
+
+#endif
@@ -4,39 +4,66 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include <gsl/gsl_assert>
 #include <gsl/pointers>
 
+#include "aisdi/instrumentation.hpp"
+#include "aisdi/Transparent.hpp"
+#include "aisdi/ValueTraits.hpp"
+
 namespace aisdi {
 
+namespace detail {
+
+struct TreeMapProbeTag
+{
+    static const char* name() noexcept { return "TreeMap"; }
+};
+
+// Internals of TreeMap and TreeSet, which differ only in items kept by
+// nodes (see ValueTraits.hpp) and in operations on mapped values
 template<typename Key,
-         typename T,
-         typename Compare = std::less<Key>>
-class TreeMap
+         typename ValueTraits,
+         typename Compare>
+class SearchTree
 {
 public:
     class ConstIterator;
     class Iterator;
+    class NodeHandle;
+    struct InsertReturnType;
 
     using key_type = Key;
-    using mapped_type = T;
-    using value_type = std::pair<const Key, T>;
+    using value_type = typename ValueTraits::value_type;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using key_compare = Compare;
-    using pointer = value_type*;
+    using pointer = typename ValueTraits::pointer;
     using const_pointer = const value_type*;
-    using reference = value_type&;
+    using reference = typename ValueTraits::reference;
     using const_reference = const value_type&;
     using iterator = Iterator;
     using const_iterator = ConstIterator;
+    using node_type = NodeHandle;
+    using insert_return_type = InsertReturnType;
+
+protected:
+    // Lookups by any K are enabled, when Compare is transparent.
+    // Iterators are excluded, so erase(pos) is not hijacked.
+    template<typename K, typename C = Compare>
+    using EnableIfTransparent =
+        std::enable_if_t<detail::IsTransparent<C>::value
+                         && !std::is_convertible<K, const_iterator>::value>;
 
-    TreeMap()
+public:
+    SearchTree()
     {
         // Postconditions
         Ensures(empty());
@@ -44,16 +71,16 @@ public:
         Ensures(begin() == end());
     }
 
-    TreeMap(const TreeMap& other)
-        :   TreeMap()
+    SearchTree(const SearchTree& other)
+        :   SearchTree()
     {
         insert(other.begin(), other.end());
 
         Ensures(*this == other);
     }
 
-    TreeMap(TreeMap&& other) noexcept
-        :   TreeMap()
+    SearchTree(SearchTree&& other) noexcept
+        :   SearchTree()
     {
         *this = std::move(other);
 
@@ -62,17 +89,17 @@ public:
         Ensures(other.begin() == other.end());
     }
 
-    TreeMap(std::initializer_list<value_type> ilist)
-        :   TreeMap()
+    SearchTree(std::initializer_list<value_type> ilist)
+        :   SearchTree()
     {
         insert(ilist);
 
         Ensures(size() == ilist.size());
         Ensures(std::all_of(ilist.begin(), ilist.end(),
-            [this](const auto& v) { return this->contains(v.first); }));
+            [this](const auto& v) { return this->contains(ValueTraits::key(v)); }));
     }
 
-    TreeMap& operator=(const TreeMap& other)
+    SearchTree& operator=(const SearchTree& other)
     {
         if(this != &other)
         {
@@ -84,7 +111,7 @@ public:
         return *this;
     }
 
-    TreeMap& operator=(TreeMap&& other) noexcept
+    SearchTree& operator=(SearchTree&& other) noexcept
     {
         if(this != &other)
         {
@@ -106,7 +133,7 @@ public:
         return *this;
     }
 
-    ~TreeMap()
+    ~SearchTree()
     {
         clear();
     }
@@ -125,14 +152,14 @@ public:
 
     const_iterator begin() const
     {
-        auto& self = const_cast<TreeMap&>(*this);
+        auto& self = const_cast<SearchTree&>(*this);
         const iterator it = self.begin();
         return it;
     }
 
     const_iterator end() const
     {
-        auto& self = const_cast<TreeMap&>(*this);
+        auto& self = const_cast<SearchTree&>(*this);
         const iterator it = self.end();
         return it;
     }
@@ -155,7 +182,7 @@ public:
             while(node->parent && !node->right)
             {
                 const auto parent = gsl::make_not_null(node->parent);
-                delete static_cast<Node*>(node.get());
+                destroyNode(node);
                 node = parent;
             }
 
@@ -182,85 +209,62 @@ public:
 
         const auto result = std::next(pos);
         const auto node = gsl::make_not_null(pos.node_);
-        const auto parent = gsl::make_not_null(node->parent);
-
-        auto left = node->left;
-        auto right = node->right;
-        Node* next = nullptr;
-
-        if(left)
-        {
-            next = left;
-            const auto rightOfNext = next->right;
-
-            if(!right)
-            {
-                right = rightOfNext;
-            }
-            else
-            {
-                right->leftmost()->left = rightOfNext;
-            }
-
-            next->right = right;
-        }
-        else if(right)
-        {
-            next = right;
-        }
+        unlinkNode(node);
+        destroyNode(node);
+        return result;
+    }
 
-        if(parent->left == node)
-        {
-            parent->left = next;
-            if(node == first_)
-            {
-                first_ = (next) ? next->leftmost() : parent;
-            }
-        }
-        else
-        {
-            parent->right = next;
-        }
+    // Unlinks node at pos and hands it over without copying its item
+    node_type extract(const const_iterator& pos)
+    {
+        Expects(pos != end());
 
-        if(next)
-        {
-            next->parent = parent;
-        }
+        const auto node = gsl::make_not_null(pos.node_);
+        unlinkNode(node);
+        return node_type{static_cast<Node*>(node.get())};
+    }
 
-        delete static_cast<Node*>(node.get());
-        --size_;
-        return result;
+    node_type extract(const key_type& key)
+    {
+        const auto pos = find(key);
+        return (pos != end()) ? extract(pos) : node_type{};
     }
 
+
     size_type erase(const key_type& key)
     {
-        auto pos = find(key);
-        if(pos == end())
-        {
-            return 0;
-        }
+        return eraseKey(key);
+    }
 
-        erase(pos);
-        return 1;
+    template<typename K, typename = EnableIfTransparent<K>>
+    size_type erase(const K& key)
+    {
+        return eraseKey(key);
     }
 
     iterator find(const key_type& key)
     {
-        const auto result = locate(key);
-        const auto status = result.first;
-        if(status == LocateStatus::Found)
-        {
-            const auto node = result.second;
-            return iterator{node};
-        }
-
-        return end();
+        return findKey(key);
     }
 
     const_iterator find(const key_type& key) const
     {
-        auto& self = const_cast<TreeMap&>(*this);
-        iterator it = self.find(key);
+        auto& self = const_cast<SearchTree&>(*this);
+        iterator it = self.findKey(key);
+        return it;
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    iterator find(const K& key)
+    {
+        return findKey(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    const_iterator find(const K& key) const
+    {
+        auto& self = const_cast<SearchTree&>(*this);
+        iterator it = self.findKey(key);
         return it;
     }
 
@@ -269,27 +273,77 @@ public:
         return (find(key) != end()) ? true : false;
     }
 
-    mapped_type& at(const key_type& key)
+    template<typename K, typename = EnableIfTransparent<K>>
+    bool contains(const K& key) const
     {
-        auto it = find(key);
-        Expects(it != end());
-
-        return it->second;
+        return (find(key) != end()) ? true : false;
     }
 
-    const mapped_type& at(const key_type& key) const
+    size_type count(const key_type& key) const
     {
-        return const_cast<TreeMap&>(*this).at(key);
+        return contains(key) ? 1 : 0;
     }
 
-    mapped_type& operator[](const key_type& key)
+    template<typename K, typename = EnableIfTransparent<K>>
+    size_type count(const K& key) const
     {
-        return this->try_emplace(key).first->second;
+        return contains(key) ? 1 : 0;
     }
 
+    // Returns position of the item with key of value and whether it was
+    // inserted, so a key is both checked and added with a single lookup
     std::pair<iterator, bool> insert(const value_type& value)
     {
-        return try_emplace(value.first, value.second);
+        return emplaceKey(ValueTraits::key(value), value);
+    }
+
+    // Links node of the handle, unless its key is already present. Then
+    // the handle is given back in the result. Nothing is allocated or copied.
+    insert_return_type insert(node_type&& node)
+    {
+        if(node.empty())
+        {
+            return {end(), false, node_type{}};
+        }
+
+        const auto result = locate(node.key());
+        const auto status = result.first;
+        if(status == LocateStatus::Found)
+        {
+            return {iterator{result.second}, false, std::move(node)};
+        }
+
+        const auto released = gsl::make_not_null(node.release());
+        linkNode(status, result.second, released);
+        return {iterator{released}, true, node_type{}};
+    }
+
+    // Moves nodes of the other tree, whose keys are not present in this
+    // one, by relinking them. Other items stay where they were.
+    void merge(SearchTree& other)
+    {
+        if(&other == this)
+        {
+            return;
+        }
+
+        for(auto pos = other.begin(); pos != other.end();)
+        {
+            const auto current = pos++;
+            const auto node = gsl::make_not_null(static_cast<Node*>(current.node_));
+            const auto result = locate(node->key());
+            const auto status = result.first;
+            if(status != LocateStatus::Found)
+            {
+                other.unlinkNode(node);
+                linkNode(status, result.second, node);
+            }
+        }
+    }
+
+    void merge(SearchTree&& other)
+    {
+        merge(other);
     }
 
     template<typename InputIt>
@@ -307,8 +361,21 @@ public:
         insert(ilist.begin(), ilist.end());
     }
 
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+protected:
+    // Returns node of the key, or a new one constructed of args, if key
+    // is missing. Args are not used, when key is present.
     template<typename... Args>
-    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+    std::pair<iterator, bool> emplaceKey(const key_type& key, Args&&... args)
     {
         auto result = locate(key);
         auto status = result.first;
@@ -320,38 +387,25 @@ public:
 
         auto parent = result.second;
         const auto node =
-            gsl::make_not_null(
-                new Node(parent,
-                         std::piecewise_construct,
-                         std::forward_as_tuple(key),
-                         std::forward_as_tuple(std::forward<Args>(args)...)));
+            gsl::make_not_null(new Node(parent, std::forward<Args>(args)...));
+        Probe::allocated(sizeof(Node));
 
-        if(status == LocateStatus::OnLeft)
-        {
-            parent->left = node;
-
-            if(parent == first_)
-            {
-                first_ = node;
-            }
-        }
-        else
-        {
-            parent->right = node;
-        }
-
-        ++size_;
+        linkNode(status, parent, node);
         return std::make_pair(iterator{node}, true);
     }
 
-    size_type size() const noexcept
+    template<typename K>
+    iterator findKey(const K& key)
     {
-        return size_;
-    }
+        const auto result = locate(key);
+        const auto status = result.first;
+        if(status == LocateStatus::Found)
+        {
+            const auto node = result.second;
+            return iterator{node};
+        }
 
-    bool empty() const noexcept
-    {
-        return (size_ == 0);
+        return end();
     }
 
 private:
@@ -429,22 +483,20 @@ private:
 
         const key_type& key() const noexcept
         {
-            return value.first;
-        }
-
-        mapped_type& mapped()
-        {
-            return value.second;
-        }
-
-        const mapped_type& mapped() const
-        {
-            return value.second;
+            return ValueTraits::key(value);
         }
 
         value_type value;
     };
 
+    using Probe = instrumentation::Probe<detail::TreeMapProbeTag>;
+
+    static void destroyNode(gsl::not_null<BasicNode*> node) noexcept
+    {
+        delete static_cast<Node*>(node.get());
+        Probe::deallocated(sizeof(Node));
+    }
+
     enum class LocateStatus
     {
         Found,
@@ -452,7 +504,110 @@ private:
         OnRight
     };
 
-    std::pair<LocateStatus, gsl::not_null<BasicNode*>> locate(const key_type& key)
+    // Puts detached node as a child of parent, on side given by status
+    void linkNode(LocateStatus status,
+                  gsl::not_null<BasicNode*> parent,
+                  gsl::not_null<Node*> node)
+    {
+        node->parent = parent;
+        node->left = nullptr;
+        node->right = nullptr;
+
+        if(status == LocateStatus::OnLeft)
+        {
+            parent->left = node;
+
+            if(parent == first_)
+            {
+                first_ = node;
+            }
+        }
+        else
+        {
+            parent->right = node;
+        }
+
+        ++size_;
+        Probe::sized(size_);
+    }
+
+    // Detaches node from the tree, but does not destroy it
+    void unlinkNode(gsl::not_null<BasicNode*> node)
+    {
+        const auto parent = gsl::make_not_null(node->parent);
+
+        auto left = node->left;
+        auto right = node->right;
+        Node* next = nullptr;
+
+        if(left)
+        {
+            next = left;
+            const auto rightOfNext = next->right;
+
+            if(!right)
+            {
+                right = rightOfNext;
+            }
+            else
+            {
+                const auto leftmost = right->leftmost();
+                leftmost->left = rightOfNext;
+                if(rightOfNext)
+                {
+                    rightOfNext->parent = leftmost;
+                }
+            }
+
+            next->right = right;
+            if(right)
+            {
+                right->parent = next;
+            }
+        }
+        else if(right)
+        {
+            next = right;
+        }
+
+        if(parent->left == node)
+        {
+            parent->left = next;
+            if(node == first_)
+            {
+                first_ = (next) ? next->leftmost() : parent;
+            }
+        }
+        else
+        {
+            parent->right = next;
+        }
+
+        if(next)
+        {
+            next->parent = parent;
+        }
+
+        --size_;
+    }
+
+    template<typename K>
+    size_type eraseKey(const K& key)
+    {
+        auto pos = findKey(key);
+        if(pos == end())
+        {
+            return 0;
+        }
+
+        erase(pos);
+        return 1;
+    }
+
+    // K is key_type, unless Compare is transparent. Keys are equivalent,
+    // when neither of them is ordered before the other.
+    template<typename K>
+    std::pair<LocateStatus, gsl::not_null<BasicNode*>> locate(const K& key)
     {
         auto parent = gsl::make_not_null(&root_);
         auto node = parent->left;
@@ -464,22 +619,21 @@ private:
 
             Expects(current->parent); // Is not the end()
             const auto& nodeKey = static_cast<Node*>(current.get())->key();
-            if(nodeKey == key)
-            {
-                return std::make_pair(LocateStatus::Found, current);
-            }
-
             parent = current;
             if(comp_(key, nodeKey))
             {
                 status = LocateStatus::OnLeft;
                 node = current->left;
             }
-            else
+            else if(comp_(nodeKey, key))
             {
                 status = LocateStatus::OnRight;
                 node = current->right;
             }
+            else
+            {
+                return std::make_pair(LocateStatus::Found, current);
+            }
         }
 
         return std::make_pair(status, parent);
@@ -498,9 +652,9 @@ private:
     size_type size_ = 0;
 };
 
-template<typename Key, typename T, typename Compare>
-bool operator==(const TreeMap<Key, T, Compare>& lhs,
-                const TreeMap<Key, T, Compare>& rhs)
+template<typename Key, typename ValueTraits, typename Compare>
+bool operator==(const SearchTree<Key, ValueTraits, Compare>& lhs,
+                const SearchTree<Key, ValueTraits, Compare>& rhs)
 {
     if(lhs.size() != rhs.size())
     {
@@ -510,26 +664,26 @@ bool operator==(const TreeMap<Key, T, Compare>& lhs,
     return std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template<typename Key, typename T, typename Compare>
-bool operator!=(const TreeMap<Key, T, Compare>& lhs,
-                const TreeMap<Key, T, Compare>& rhs)
+template<typename Key, typename ValueTraits, typename Compare>
+bool operator!=(const SearchTree<Key, ValueTraits, Compare>& lhs,
+                const SearchTree<Key, ValueTraits, Compare>& rhs)
 {
     return !(lhs == rhs);
 }
 
 template<typename Key,
-         typename T,
+         typename ValueTraits,
          typename Compare>
-class TreeMap<Key, T, Compare>::ConstIterator
+class SearchTree<Key, ValueTraits, Compare>::ConstIterator
 {
-    friend TreeMap<Key, T, Compare>;
+    friend SearchTree<Key, ValueTraits, Compare>;
 
 public:
     using iterator_category = std::bidirectional_iterator_tag;
-    using value_type = std::pair<const Key, T>;
+    using value_type = typename SearchTree::value_type;
     using difference_type = std::ptrdiff_t;
-    using pointer = const std::pair<const Key, T>*;
-    using reference = const std::pair<const Key, T>&;
+    using pointer = typename SearchTree::const_pointer;
+    using reference = typename SearchTree::const_reference;
 
     ConstIterator() = default;
 
@@ -612,19 +766,19 @@ private:
 };
 
 template<typename Key,
-         typename T,
+         typename ValueTraits,
          typename Compare>
-class TreeMap<Key, T, Compare>::Iterator
+class SearchTree<Key, ValueTraits, Compare>::Iterator
     :   public ConstIterator
 {
-    friend TreeMap<Key, T, Compare>;
+    friend SearchTree<Key, ValueTraits, Compare>;
 
 public:
     using iterator_category = std::bidirectional_iterator_tag;
-    using value_type = std::pair<const Key, T>;
+    using value_type = typename SearchTree::value_type;
     using difference_type = std::ptrdiff_t;
-    using pointer = std::pair<const Key, T>*;
-    using reference = std::pair<const Key, T>&;
+    using pointer = typename SearchTree::pointer;
+    using reference = typename SearchTree::reference;
 
     Iterator() = default;
 
@@ -670,6 +824,176 @@ private:
     {}
 };
 
+// Owns a node extracted from a tree, until it is inserted into one
+template<typename Key,
+         typename ValueTraits,
+         typename Compare>
+class SearchTree<Key, ValueTraits, Compare>::NodeHandle
+{
+    friend SearchTree<Key, ValueTraits, Compare>;
+
+public:
+    using key_type = typename SearchTree::key_type;
+    using value_type = typename SearchTree::value_type;
+
+    NodeHandle() = default;
+
+    NodeHandle(NodeHandle&& other) noexcept
+        :   node_(other.release())
+    {}
+
+    NodeHandle& operator=(NodeHandle&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            node_ = other.release();
+        }
+
+        return *this;
+    }
+
+    NodeHandle(const NodeHandle&) = delete;
+    NodeHandle& operator=(const NodeHandle&) = delete;
+
+    ~NodeHandle()
+    {
+        reset();
+    }
+
+    bool empty() const noexcept
+    {
+        return (node_ == nullptr);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return !empty();
+    }
+
+    const key_type& key() const
+    {
+        Expects(!empty());
+        return node_->key();
+    }
+
+    typename SearchTree::reference value() const
+    {
+        Expects(!empty());
+        return node_->value;
+    }
+
+    // Available for maps only
+    auto& mapped() const
+    {
+        return value().second;
+    }
+
+private:
+    explicit NodeHandle(Node* node) noexcept
+        :   node_(node)
+    {}
+
+    Node* release() noexcept
+    {
+        const auto node = node_;
+        node_ = nullptr;
+        return node;
+    }
+
+    void reset() noexcept
+    {
+        if(node_)
+        {
+            destroyNode(release());
+        }
+    }
+
+    Node* node_ = nullptr;
+};
+
+template<typename Key,
+         typename ValueTraits,
+         typename Compare>
+struct SearchTree<Key, ValueTraits, Compare>::InsertReturnType
+{
+    iterator position;
+    bool inserted;
+    node_type node;
+};
+
+} // namespace detail
+
+template<typename Key,
+         typename T,
+         typename Compare = std::less<Key>>
+class TreeMap
+    :   public detail::SearchTree<Key, detail::MapValueTraits<Key, T>, Compare>
+{
+    using Base = detail::SearchTree<Key, detail::MapValueTraits<Key, T>, Compare>;
+
+    template<typename K>
+    using EnableIfTransparent = typename Base::template EnableIfTransparent<K>;
+
+public:
+    using mapped_type = T;
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::iterator;
+
+    TreeMap() = default;
+
+    TreeMap(std::initializer_list<value_type> ilist)
+        :   Base(ilist)
+    {}
+
+    mapped_type& at(const key_type& key)
+    {
+        return mappedAt(key);
+    }
+
+    const mapped_type& at(const key_type& key) const
+    {
+        return const_cast<TreeMap&>(*this).mappedAt(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    mapped_type& at(const K& key)
+    {
+        return mappedAt(key);
+    }
+
+    template<typename K, typename = EnableIfTransparent<K>>
+    const mapped_type& at(const K& key) const
+    {
+        return const_cast<TreeMap&>(*this).mappedAt(key);
+    }
+
+    mapped_type& operator[](const key_type& key)
+    {
+        return this->try_emplace(key).first->second;
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+    {
+        return this->emplaceKey(key,
+                                std::piecewise_construct,
+                                std::forward_as_tuple(key),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+private:
+    template<typename K>
+    mapped_type& mappedAt(const K& key)
+    {
+        auto it = this->findKey(key);
+        Expects(it != this->end());
+
+        return it->second;
+    }
+};
+
 } // namespace aisdi
 
 #endif
@@ -0,0 +1,33 @@
+#ifndef AISDI_TREESET_HPP
+#define AISDI_TREESET_HPP
+
+#include <functional>
+#include <initializer_list>
+
+#include "aisdi/TreeMap.hpp"
+#include "aisdi/ValueTraits.hpp"
+
+namespace aisdi {
+
+// Ordered set sharing the tree of TreeMap. Nodes keep bare keys, and
+// insert() tells whether the key was new, so the key is looked up once.
+template<typename Key,
+         typename Compare = std::less<Key>>
+class TreeSet
+    :   public detail::SearchTree<Key, detail::SetValueTraits<Key>, Compare>
+{
+    using Base = detail::SearchTree<Key, detail::SetValueTraits<Key>, Compare>;
+
+public:
+    using typename Base::value_type;
+
+    TreeSet() = default;
+
+    TreeSet(std::initializer_list<value_type> ilist)
+        :   Base(ilist)
+    {}
+};
+
+} // namespace aisdi
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef AISDI_VALUETRAITS_HPP
+#define AISDI_VALUETRAITS_HPP
+
+#include <utility>
+
+namespace aisdi {
+namespace detail {
+
+// Tells a container (hash table or search tree), how its items are stored.
+// Maps keep key-value pairs, sets keep bare keys, so nodes of a set do not
+// waste space for any mapped value.
+template<typename Key, typename T>
+struct MapValueTraits
+{
+    using value_type = std::pair<const Key, T>;
+    using reference = value_type&;
+    using pointer = value_type*;
+
+    static const Key& key(const value_type& value) noexcept
+    {
+        return value.first;
+    }
+
+    // Compares items, whose keys are already known to be equal
+    static bool equalMapped(const value_type& lhs, const value_type& rhs)
+    {
+        return (lhs.second == rhs.second);
+    }
+};
+
+// Keys of a set may not be modified through its iterators
+template<typename Key>
+struct SetValueTraits
+{
+    using value_type = Key;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+    static const Key& key(const value_type& value) noexcept
+    {
+        return value;
+    }
+
+    static bool equalMapped(const value_type&, const value_type&) noexcept
+    {
+        return true;
+    }
+};
+
+} // namespace detail
+} // namespace aisdi
+
+#endif
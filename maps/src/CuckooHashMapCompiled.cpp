@@ -0,0 +1 @@
+#include "aisdi/CuckooHashMap.hpp"
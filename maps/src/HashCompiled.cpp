@@ -0,0 +1 @@
+#include "aisdi/Hash.hpp"
@@ -0,0 +1 @@
+#include "aisdi/HashSet.hpp"
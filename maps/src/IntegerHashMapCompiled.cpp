@@ -0,0 +1 @@
+#include "aisdi/IntegerHashMap.hpp"
@@ -0,0 +1 @@
+#include "aisdi/MappedStaticHashMap.hpp"
@@ -0,0 +1 @@
+#include "aisdi/StaticHashMap.hpp"
@@ -0,0 +1 @@
+#include "aisdi/TreeSet.hpp"
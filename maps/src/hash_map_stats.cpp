@@ -0,0 +1,133 @@
+// Prints shape of hash maps built from a file of keys (one key per line),
+// for each combination of hasher and bucket policy:
+//
+//     hash_map_stats keys.txt [max_load_factor]
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "aisdi/BucketPolicy.hpp"
+#include "aisdi/Hash.hpp"
+#include "aisdi/HashMap.hpp"
+
+namespace
+{
+
+std::vector<std::string> readKeys(const std::string& path)
+{
+    auto file = std::ifstream{path};
+    if(!file)
+    {
+        throw std::runtime_error("Could not open key file " + path);
+    }
+
+    auto keys = std::vector<std::string>{};
+    auto key = std::string{};
+    while(std::getline(file, key))
+    {
+        keys.push_back(key);
+    }
+
+    return keys;
+}
+
+void printHeader()
+{
+    std::cout << std::left << std::setw(12) << "hash"
+              << std::setw(12) << "policy" << std::right
+              << std::setw(10) << "size"
+              << std::setw(10) << "buckets"
+              << std::setw(8) << "load"
+              << std::setw(8) << "empty"
+              << std::setw(8) << "max"
+              << std::setw(8) << "hit"
+              << std::setw(8) << "miss"
+              << std::setw(12) << "bytes"
+              << "  chain lengths\n";
+}
+
+template<typename Hash, typename BucketPolicy>
+void printStats(const char* hashName,
+                const char* policyName,
+                const std::vector<std::string>& keys,
+                float maxLoadFactor)
+{
+    auto map = aisdi::HashMap<std::string, std::size_t, Hash,
+                              std::equal_to<std::string>, BucketPolicy>{};
+    map.max_load_factor(maxLoadFactor);
+    for(std::size_t line = 0; line < keys.size(); ++line)
+    {
+        map[keys[line]] = line;
+    }
+
+    const auto stats = map.stats();
+    std::cout << std::left << std::setw(12) << hashName
+              << std::setw(12) << policyName << std::right
+              << std::setw(10) << stats.size
+              << std::setw(10) << stats.bucketCount
+              << std::fixed << std::setprecision(2)
+              << std::setw(8) << map.load_factor()
+              << std::setw(8) << stats.emptyBucketRatio
+              << std::setw(8) << stats.maxChainLength
+              << std::setw(8) << stats.meanSuccessfulProbes
+              << std::setw(8) << stats.meanUnsuccessfulProbes
+              << std::setw(12) << stats.memoryBytes
+              << " ";
+    for(std::size_t length = 0; length < stats.bucketSizes.size(); ++length)
+    {
+        if(stats.bucketSizes[length] > 0)
+        {
+            std::cout << ' ' << length << ':' << stats.bucketSizes[length];
+        }
+    }
+    std::cout << '\n';
+}
+
+template<typename Hash>
+void printPolicies(const char* hashName,
+                   const std::vector<std::string>& keys,
+                   float maxLoadFactor)
+{
+    printStats<Hash, aisdi::ModuloBucketPolicy>(hashName, "modulo", keys, maxLoadFactor);
+    printStats<Hash, aisdi::FibonacciBucketPolicy>(hashName, "fibonacci", keys, maxLoadFactor);
+    printStats<Hash, aisdi::AvalancheBucketPolicy>(hashName, "avalanche", keys, maxLoadFactor);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " KEY_FILE [MAX_LOAD_FACTOR]\n";
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const auto keys = readKeys(argv[1]);
+        const auto maxLoadFactor = (argc == 3) ? std::stof(argv[2]) : 1.0f;
+        if(!(maxLoadFactor > 0.0f))
+        {
+            throw std::invalid_argument("Maximal load factor has to be positive");
+        }
+
+        printHeader();
+        printPolicies<std::hash<std::string>>("std::hash", keys, maxLoadFactor);
+        printPolicies<aisdi::StringHash>("wyhash", keys, maxLoadFactor);
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr << argv[0] << ": " << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
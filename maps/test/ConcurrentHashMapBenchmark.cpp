@@ -0,0 +1,104 @@
+#include <hayai.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <aisdi/ConcurrentHashMap.hpp>
+#include <aisdi/HashMap.hpp>
+
+constexpr auto Size = 100000;
+constexpr auto OperationsPerThread = 10000;
+
+// HashMap behind a single mutex, as used before ConcurrentHashMap
+class LockedHashMap
+{
+public:
+    bool find(int key, int& value) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto pos = map_.find(key);
+        if(pos == map_.end())
+        {
+            return false;
+        }
+
+        value = pos->second;
+        return true;
+    }
+
+    void insert_or_assign(int key, int value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.insert_or_assign(key, value);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    aisdi::HashMap<int, int> map_;
+};
+
+// Every thread of the processor does read-mostly work
+// (nine lookups per one assignment) on a shared map
+template<typename Map>
+class ThroughputBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        for(auto i = 0; i < Size; ++i)
+        {
+            container.insert_or_assign(i, i);
+        }
+    }
+
+    void run()
+    {
+        const auto threadCount = std::max(1u, std::thread::hardware_concurrency());
+        auto threads = std::vector<std::thread>{};
+        for(auto t = 0u; t < threadCount; ++t)
+        {
+            threads.emplace_back([this, t]
+                {
+                    auto seed = t + 1;
+                    auto value = 0;
+                    for(auto i = 0; i < OperationsPerThread; ++i)
+                    {
+                        seed = seed * 1103515245u + 12345u;
+                        const auto key = static_cast<int>((seed >> 8) % Size);
+                        if(i % 10 == 0)
+                        {
+                            container.insert_or_assign(key, i);
+                        }
+                        else
+                        {
+                            container.find(key, value);
+                        }
+                    }
+                });
+        }
+
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    Map container;
+};
+
+using LockedThroughputBenchmark = ThroughputBenchmark<LockedHashMap>;
+using ShardedThroughputBenchmark = ThroughputBenchmark<aisdi::ConcurrentHashMap<int, int>>;
+
+BENCHMARK_F(LockedThroughputBenchmark, ReadMostlyTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(ShardedThroughputBenchmark, ReadMostlyTest, 10, 1)
+{
+    run();
+}
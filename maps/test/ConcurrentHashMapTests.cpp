@@ -0,0 +1,185 @@
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "aisdi/ConcurrentHashMap.hpp"
+
+using Map = aisdi::ConcurrentHashMap<std::int32_t, std::string>;
+
+BOOST_AUTO_TEST_SUITE(ConcurrentHashMapTests)
+
+BOOST_AUTO_TEST_CASE(GivenShardCount_WhenCreatingMap_ThenItIsRoundedUpToPowerOfTwo)
+{
+  BOOST_CHECK(Map(1).shard_count() == 1);
+  BOOST_CHECK(Map(5).shard_count() == 8);
+  BOOST_CHECK(Map(64).shard_count() == 64);
+  BOOST_CHECK(Map().empty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyMap_WhenInsertingItems_ThenTheyMayBeFound)
+{
+  Map map(4);
+
+  BOOST_CHECK(map.insert_or_assign(42, "Alice"));
+  BOOST_CHECK(map.insert_or_assign(27, "Bob"));
+  BOOST_CHECK(!map.insert_or_assign(42, "Chuck"));
+
+  std::string value;
+  BOOST_CHECK(map.find(42, value));
+  BOOST_CHECK(value == "Chuck");
+  BOOST_CHECK(!map.find(13, value));
+  BOOST_CHECK(map.contains(27));
+  BOOST_CHECK(map.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenErasingItems_ThenOnlyPresentOnesAreCounted)
+{
+  Map map;
+  map.insert_or_assign(42, "Alice");
+
+  BOOST_CHECK(map.erase(42) == 1);
+  BOOST_CHECK(map.erase(42) == 0);
+  BOOST_CHECK(map.empty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenVisitingKey_ThenValueMayBeModifiedInPlace)
+{
+  Map map;
+  map.insert_or_assign(42, "Alice");
+
+  BOOST_CHECK(map.visit(42, [](std::string& value) { value += " and Bob"; }));
+  BOOST_CHECK(!map.visit(13, [](std::string&) { BOOST_FAIL("Missing key visited"); }));
+
+  const auto& constMap = map;
+  auto visited = std::string{};
+  BOOST_CHECK(constMap.visit(42, [&visited](const std::string& value) { visited = value; }));
+  BOOST_CHECK(visited == "Alice and Bob");
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenIteratingInParallel_ThenEveryItemIsVisitedOnce)
+{
+  Map map(16);
+  for (std::int32_t i = 0; i < 1000; ++i)
+  {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+
+  // Boost.Test assertions are not thread-safe, so they are checked afterwards
+  std::vector<std::atomic<int>> visits(1000);
+  std::atomic<int> wrongValues{0};
+  map.for_each([&visits, &wrongValues](const Map::value_type& item)
+               {
+                 if (item.second != std::to_string(item.first))
+                 {
+                   ++wrongValues;
+                 }
+                 ++visits[static_cast<std::size_t>(item.first)];
+               },
+               4);
+
+  BOOST_CHECK(wrongValues == 0);
+  for (const auto& count : visits)
+  {
+    BOOST_CHECK(count == 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingFunction_WhenIteratingInParallel_ThenExceptionIsRethrown)
+{
+  Map map(16);
+  for (std::int32_t i = 0; i < 100; ++i)
+  {
+    map.insert_or_assign(i, "Alice");
+  }
+
+  BOOST_CHECK_THROW(map.for_each([](const Map::value_type&) { throw std::runtime_error("Bob"); }, 4),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyWriters_WhenInsertingConcurrently_ThenNoItemIsLost)
+{
+  Map map(8);
+  constexpr auto ThreadCount = 8;
+  constexpr auto ItemsPerThread = 2000;
+
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < ThreadCount; ++t)
+  {
+    threads.emplace_back([&map, t]
+                         {
+                           for (auto i = 0; i < ItemsPerThread; ++i)
+                           {
+                             const auto key = t * ItemsPerThread + i;
+                             map.insert_or_assign(key, std::to_string(key));
+                             if (i % 2 == 0)
+                             {
+                               map.erase(key);
+                             }
+                           }
+                         });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  BOOST_CHECK(map.size() == ThreadCount * ItemsPerThread / 2);
+  std::string value;
+  BOOST_CHECK(map.find(ItemsPerThread + 1, value));
+  BOOST_CHECK(value == std::to_string(ItemsPerThread + 1));
+  BOOST_CHECK(!map.contains(ItemsPerThread));
+}
+
+BOOST_AUTO_TEST_CASE(GivenReadersAndWriters_WhenRunningConcurrently_ThenReadersSeeConsistentValues)
+{
+  Map map(4);
+  for (std::int32_t i = 0; i < 100; ++i)
+  {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistentReads{0};
+  std::vector<std::thread> readers;
+  for (auto t = 0; t < 4; ++t)
+  {
+    readers.emplace_back([&]
+                         {
+                           std::string value;
+                           while (!done)
+                           {
+                             for (std::int32_t i = 0; i < 100; ++i)
+                             {
+                               if (map.find(i, value) && value != std::to_string(i)
+                                   && value != std::to_string(-i))
+                               {
+                                 ++inconsistentReads;
+                               }
+                             }
+                           }
+                         });
+  }
+
+  for (auto round = 0; round < 100; ++round)
+  {
+    for (std::int32_t i = 0; i < 100; ++i)
+    {
+      map.insert_or_assign(i, std::to_string(round % 2 == 0 ? -i : i));
+    }
+  }
+  done = true;
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+
+  BOOST_CHECK(inconsistentReads == 0);
+  BOOST_CHECK(map.size() == 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
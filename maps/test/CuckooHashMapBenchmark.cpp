@@ -0,0 +1,164 @@
+#include <hayai.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <aisdi/CuckooHashMap.hpp>
+#include <aisdi/HashMap.hpp>
+
+constexpr auto Size = 1000000;
+constexpr auto Lookups = 1000000;
+
+using Cuckoo = aisdi::CuckooHashMap<std::uint32_t, std::uint32_t>;
+using Chained = aisdi::HashMap<std::uint32_t, std::uint32_t>;
+
+// Random keys, shared by all benchmarks. Keys of the second half are
+// never inserted, so they are looked up by unsuccessful searches.
+const std::vector<std::uint32_t>& keys()
+{
+    static const auto keys = []
+        {
+            auto engine = std::mt19937{};
+            auto keys = std::vector<std::uint32_t>{};
+            keys.reserve(2 * Size);
+            for(auto i = 0; i < 2 * Size; ++i)
+            {
+                keys.push_back(engine());
+            }
+            return keys;
+        }();
+    return keys;
+}
+
+template<typename Map>
+class InsertionBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        keys();
+    }
+
+    void run()
+    {
+        auto map = Map{};
+        for(auto i = 0; i < Size; ++i)
+        {
+            map[keys()[static_cast<std::size_t>(i)]] = static_cast<std::uint32_t>(i);
+        }
+    }
+};
+
+using CuckooInsertionBenchmark = InsertionBenchmark<Cuckoo>;
+using ChainedInsertionBenchmark = InsertionBenchmark<Chained>;
+
+BENCHMARK_F(CuckooInsertionBenchmark, InsertTest, 5, 1)
+{
+    run();
+}
+
+BENCHMARK_F(ChainedInsertionBenchmark, InsertTest, 5, 1)
+{
+    run();
+}
+
+// Keys are looked up in random order, so nearly every lookup misses cache.
+// Independent lookups overlap their cache misses, dependent ones do not.
+template<typename Map>
+class SearchingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        map();
+        if(hits.empty())
+        {
+            auto engine = std::mt19937{42};
+            auto index = std::uniform_int_distribution<std::size_t>{0, Size - 1};
+            for(auto i = 0; i < Lookups; ++i)
+            {
+                const auto pos = index(engine);
+                hits.push_back(keys()[pos]);
+                misses.push_back(keys()[Size + pos]);
+            }
+        }
+    }
+
+    static const Map& map()
+    {
+        static const auto map = []
+            {
+                auto map = Map{};
+                for(auto i = 0; i < Size; ++i)
+                {
+                    map[keys()[static_cast<std::size_t>(i)]] = static_cast<std::uint32_t>(i);
+                }
+                return map;
+            }();
+        return map;
+    }
+
+    void run(const std::vector<std::uint32_t>& lookedUp)
+    {
+        auto sum = std::uint64_t{0};
+        for(auto key : lookedUp)
+        {
+            const auto pos = map().find(key);
+            sum += (pos != map().end()) ? pos->second : 1;
+        }
+        result = sum;
+    }
+
+    // Each key is chosen by the value found for the previous one, so
+    // lookups cannot overlap and every one of them pays its full latency
+    void runDependent()
+    {
+        auto index = std::uint32_t{0};
+        for(auto i = 0; i < Lookups; ++i)
+        {
+            const auto pos = map().find(hits[index]);
+            index = (pos->second + static_cast<std::uint32_t>(i)) % Lookups;
+        }
+        result = index;
+    }
+
+    std::vector<std::uint32_t> hits;
+    std::vector<std::uint32_t> misses;
+    std::uint64_t result = 0;
+};
+
+using CuckooSearchingBenchmark = SearchingBenchmark<Cuckoo>;
+using ChainedSearchingBenchmark = SearchingBenchmark<Chained>;
+
+BENCHMARK_F(CuckooSearchingBenchmark, FindTest, 10, 1)
+{
+    run(hits);
+}
+
+BENCHMARK_F(ChainedSearchingBenchmark, FindTest, 10, 1)
+{
+    run(hits);
+}
+
+BENCHMARK_F(CuckooSearchingBenchmark, FindMissingTest, 10, 1)
+{
+    run(misses);
+}
+
+BENCHMARK_F(ChainedSearchingBenchmark, FindMissingTest, 10, 1)
+{
+    run(misses);
+}
+
+BENCHMARK_F(CuckooSearchingBenchmark, DependentFindTest, 10, 1)
+{
+    runDependent();
+}
+
+BENCHMARK_F(ChainedSearchingBenchmark, DependentFindTest, 10, 1)
+{
+    runDependent();
+}
@@ -0,0 +1,542 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/CuckooHashMap.hpp"
+#include "aisdi/Hash.hpp"
+
+template <typename K>
+using Map = aisdi::CuckooHashMap<K, std::string>;
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::string>;
+
+namespace
+{
+
+template <typename K>
+K key(int value)
+{
+  return static_cast<K>(value);
+}
+
+template <>
+std::string key<std::string>(int value)
+{
+  return std::to_string(value);
+}
+
+template <typename K>
+void thenMapContainsItems(const Map<K>& map, int count)
+{
+  BOOST_REQUIRE(map.size() == static_cast<std::size_t>(count));
+  for (auto i = 0; i < count; ++i)
+  {
+    const auto pos = map.find(key<K>(i));
+    BOOST_REQUIRE(pos != map.end());
+    BOOST_CHECK(pos->second == std::to_string(i));
+  }
+}
+
+// Hashes every key to the same value
+struct ConstantHash
+{
+  std::size_t operator()(int) const
+  {
+    return 42;
+  }
+};
+
+// Identity hash, which throws once it has been called the given number of times
+struct ThrowingHash
+{
+  std::size_t operator()(int value) const
+  {
+    if (callsLeft-- == 0)
+    {
+      throw std::runtime_error("Hashing failed");
+    }
+
+    return static_cast<std::size_t>(value);
+  }
+
+  static int callsLeft;
+};
+
+int ThrowingHash::callsLeft = 0;
+
+struct CountedValue
+{
+  CountedValue(int value = 0)
+    : value(value)
+  {
+  }
+
+  CountedValue(const CountedValue& other)
+    : value(other.value)
+  {
+    ++copies;
+  }
+
+  CountedValue(CountedValue&&) noexcept = default;
+  CountedValue& operator=(const CountedValue&) = default;
+  CountedValue& operator=(CountedValue&&) noexcept = default;
+
+  int value;
+
+  static int copies;
+};
+
+int CountedValue::copies = 0;
+
+template <typename Map>
+std::vector<typename Map::key_type> keysInOrder(const Map& map)
+{
+  std::vector<typename Map::key_type> keys;
+  for (const auto& item : map)
+  {
+    keys.push_back(item.first);
+  }
+
+  return keys;
+}
+
+struct TransparentStringHash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(const std::string& value) const
+  {
+    return std::hash<std::string>()(value);
+  }
+
+  std::size_t operator()(const char* value) const
+  {
+    return std::hash<std::string>()(value);
+  }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(CuckooHashMapTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenLookingUpKey_ThenItIsNotFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.size() == 0);
+  BOOST_CHECK(map.begin() == map.end());
+  BOOST_CHECK(map.find(key<K>(42)) == map.end());
+  BOOST_CHECK(!map.contains(key<K>(42)));
+  BOOST_CHECK_THROW(map.at(key<K>(42)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInitializerList_WhenCreatingMap_ThenAllItemsAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = {{key<K>(42), "Alice"}, {key<K>(27), "Bob"}, {key<K>(13), "Chuck"}};
+
+  BOOST_CHECK(map.size() == 3);
+  BOOST_CHECK(map.at(key<K>(42)) == "Alice");
+  BOOST_CHECK(map.at(key<K>(27)) == "Bob");
+  BOOST_CHECK(map.find(key<K>(13))->second == "Chuck");
+  BOOST_CHECK(map.count(key<K>(7)) == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingPresentKey_ThenItemIsNotReplaced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  const auto first = map.insert({key<K>(42), "Alice"});
+  const auto second = map.insert({key<K>(42), "Bob"});
+
+  BOOST_CHECK(first.second);
+  BOOST_CHECK(!second.second);
+  BOOST_CHECK(second.first == first.first);
+  BOOST_CHECK(map.at(key<K>(42)) == "Alice");
+
+  map.insert_or_assign(key<K>(42), "Chuck");
+  BOOST_CHECK(map.at(key<K>(42)) == "Chuck");
+  BOOST_CHECK(map.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyKeys_WhenInserting_ThenTableGrowsAndAllAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 20000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  thenMapContainsItems(map, 20000);
+  BOOST_CHECK(map.load_factor() <= map.max_load_factor());
+  for (auto i = 20000; i < 25000; ++i)
+  {
+    BOOST_CHECK(!map.contains(key<K>(i)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullLoadFactor_WhenInserting_ThenTableIsFilledBeforeGrowing,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  map.max_load_factor(1.0f);
+  map.reserve(4096);
+  const auto bucketCount = map.bucket_count();
+
+  const auto count = static_cast<int>(bucketCount * 4 * 9 / 10);
+  for (auto i = 0; i < count; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  BOOST_CHECK(map.bucket_count() == bucketCount);
+  thenMapContainsItems(map, count);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenIterating_ThenEveryItemIsVisitedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 1000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  auto visited = std::map<K, std::string>{};
+  for (const auto& item : map)
+  {
+    BOOST_CHECK(visited.insert(item).second);
+  }
+  BOOST_CHECK(visited.size() == 1000);
+
+  auto backward = std::size_t{0};
+  for (auto pos = map.end(); pos != map.begin();)
+  {
+    --pos;
+    BOOST_CHECK(visited.count(pos->first) == 1);
+    ++backward;
+  }
+  BOOST_CHECK(backward == 1000);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenErasingKeys_ThenOnlyTheyAreRemoved,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 1000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  for (auto i = 0; i < 1000; i += 2)
+  {
+    BOOST_CHECK(map.erase(key<K>(i)) == 1);
+  }
+  BOOST_CHECK(map.erase(key<K>(0)) == 0);
+
+  BOOST_CHECK(map.size() == 500);
+  for (auto i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(map.contains(key<K>(i)) == (i % 2 == 1));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenErasingWhileIterating_ThenEveryItemIsVisitedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  auto visited = std::size_t{0};
+  for (auto pos = map.begin(); pos != map.end();)
+  {
+    pos = map.erase(pos);
+    ++visited;
+  }
+
+  BOOST_CHECK(visited == 100);
+  BOOST_CHECK(map.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCopying_ThenCopyIsEqualAndIndependent,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 500; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  auto copy = map;
+  BOOST_CHECK(copy == map);
+  thenMapContainsItems(copy, 500);
+
+  copy[key<K>(0)] = "Alice";
+  BOOST_CHECK(copy != map);
+  BOOST_CHECK(map.at(key<K>(0)) == "0");
+
+  Map<K> assigned;
+  assigned[key<K>(1000)] = "Bob";
+  assigned = map;
+  BOOST_CHECK(assigned == map);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenMoving_ThenItemsAreInTargetAndSourceIsUsable,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  auto other = std::move(map);
+  thenMapContainsItems(other, 100);
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(!map.contains(key<K>(1)));
+  map[key<K>(1)] = "Alice";
+  BOOST_CHECK(map.size() == 1);
+  BOOST_CHECK(map.at(key<K>(1)) == "Alice");
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapsWithSameItemsInOtherOrder_WhenComparing_ThenTheyAreEqual)
+{
+  Map<int> map;
+  Map<int> other(1024);
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+    other[99 - i] = std::to_string(99 - i);
+  }
+
+  BOOST_CHECK(map == other);
+
+  other[0] = "Alice";
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE(GivenKeysWithEqualHashes_WhenInserting_ThenStashKeepsThemUntilItIsFull)
+{
+  aisdi::CuckooHashMap<int, int, ConstantHash> map;
+
+  // Two buckets of four slots and a stash of four
+  for (auto i = 0; i < 12; ++i)
+  {
+    map[i] = i;
+  }
+  for (auto i = 0; i < 12; ++i)
+  {
+    BOOST_CHECK(map.at(i) == i);
+  }
+
+  BOOST_CHECK_THROW(map[12] = 12, std::length_error);
+  BOOST_CHECK(map.size() == 12);
+  BOOST_CHECK(map.at(11) == 11);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStashedKeys_WhenErasingThem_ThenOtherKeysAreStillFound)
+{
+  aisdi::CuckooHashMap<int, int, ConstantHash> map;
+  for (auto i = 0; i < 12; ++i)
+  {
+    map[i] = i;
+  }
+
+  for (auto i = 0; i < 12; i += 3)
+  {
+    BOOST_CHECK(map.erase(i) == 1);
+  }
+
+  BOOST_CHECK(map.size() == 8);
+  for (auto i = 0; i < 12; ++i)
+  {
+    BOOST_CHECK(map.contains(i) == (i % 3 != 0));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenRehashingFailsHalfway_ThenItemsAreIntact)
+{
+  ThrowingHash::callsLeft = 1000000;
+  aisdi::CuckooHashMap<int, std::string, ThrowingHash> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+  }
+  const auto bucketCount = map.bucket_count();
+  const auto keys = keysInOrder(map);
+
+  // Strings are moved to the new table, so they have to be moved back
+  // to their slots, when it cannot be completed
+  ThrowingHash::callsLeft = 50;
+  BOOST_CHECK_THROW(map.rehash(1024), std::runtime_error);
+
+  ThrowingHash::callsLeft = 1000000;
+  BOOST_CHECK(map.bucket_count() == bucketCount);
+  BOOST_CHECK(keysInOrder(map) == keys);
+  BOOST_REQUIRE(map.size() == 100);
+  for (auto i = 0; i < 100; ++i)
+  {
+    BOOST_CHECK(map.at(i) == std::to_string(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenCrowdedNewTable_WhenRehashingFailsAnywhere_ThenItemsAreIntact)
+{
+  ThrowingHash::callsLeft = 1000000;
+  aisdi::CuckooHashMap<int, std::string, ThrowingHash> map(256);
+  map.max_load_factor(1.0f);
+  for (auto i = 0; i < 120; ++i)
+  {
+    map[i * 7919] = std::to_string(i);
+  }
+  const auto bucketCount = map.bucket_count();
+  const auto keys = keysInOrder(map);
+
+  // Shrinking to a full table moves items already placed in it, and may
+  // have to start again with a larger one
+  for (auto calls = 0; calls < 400; calls += 7)
+  {
+    ThrowingHash::callsLeft = calls;
+    try
+    {
+      map.rehash(1);
+    }
+    catch (const std::runtime_error&)
+    {
+      ThrowingHash::callsLeft = 1000000;
+      BOOST_REQUIRE(map.bucket_count() == bucketCount);
+      BOOST_REQUIRE(keysInOrder(map) == keys);
+      for (auto i = 0; i < 120; ++i)
+      {
+        BOOST_REQUIRE(map.at(i * 7919) == std::to_string(i));
+      }
+
+      continue;
+    }
+
+    ThrowingHash::callsLeft = 1000000;
+    BOOST_CHECK(map.bucket_count() < bucketCount);
+    BOOST_REQUIRE(map.size() == 120);
+    for (auto i = 0; i < 120; ++i)
+    {
+      BOOST_REQUIRE(map.at(i * 7919) == std::to_string(i));
+    }
+    break;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenNothrowMovableItems_WhenTableGrows_ThenTheyAreNotCopied)
+{
+  aisdi::CuckooHashMap<int, CountedValue> map;
+  CountedValue::copies = 0;
+  for (auto i = 0; i < 1000; ++i)
+  {
+    map[i] = CountedValue{i};
+  }
+  map.rehash(4096);
+
+  BOOST_CHECK(CountedValue::copies == 0);
+  BOOST_REQUIRE(map.size() == 1000);
+  for (auto i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(map.at(i).value == i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenRehashing_ThenBucketCountIsPowerOfTwoAndItemsAreKept)
+{
+  Map<int> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[i] = std::to_string(i);
+  }
+
+  map.rehash(1000);
+
+  const auto bucketCount = map.bucket_count();
+  BOOST_CHECK(bucketCount >= 1000);
+  BOOST_CHECK((bucketCount & (bucketCount - 1)) == 0);
+  thenMapContainsItems(map, 100);
+
+  auto items = std::size_t{0};
+  for (std::size_t bucket = 0; bucket < map.bucket_count(); ++bucket)
+  {
+    BOOST_CHECK(map.bucket_size(bucket) <= 4);
+    items += map.bucket_size(bucket);
+  }
+  BOOST_CHECK(items <= map.size());
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenFindingManyKeys_ThenEachKeyIsResolvedInOrder)
+{
+  Map<int> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[i * 2] = std::to_string(i);
+  }
+
+  auto keys = std::vector<int>{};
+  for (auto i = 0; i < 200; ++i)
+  {
+    keys.push_back(i);
+  }
+
+  auto found = std::vector<Map<int>::iterator>{};
+  map.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+
+  BOOST_REQUIRE(found.size() == keys.size());
+  for (auto i = 0; i < 200; ++i)
+  {
+    BOOST_CHECK(found[static_cast<std::size_t>(i)] == map.find(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenTransparentHashAndKeyEqual_WhenLookingUpByOtherType_ThenItemIsFound)
+{
+  aisdi::CuckooHashMap<std::string, int, TransparentStringHash, std::equal_to<>> map;
+  map["Alice"] = 1;
+
+  BOOST_CHECK(map.contains("Alice"));
+  BOOST_CHECK(map.at("Alice") == 1);
+  BOOST_CHECK(map.erase("Alice") == 1);
+  BOOST_CHECK(map.empty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenSeededHasher_WhenCreatingMap_ThenItIsUsed)
+{
+  using Hash = aisdi::IntegerHash<int>;
+  aisdi::CuckooHashMap<int, int, Hash> map(16, Hash(7));
+  map[1] = 1;
+
+  BOOST_CHECK(map.hash_function()(1) == Hash(7)(1));
+  BOOST_CHECK(map.at(1) == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
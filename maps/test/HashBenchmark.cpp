@@ -0,0 +1,162 @@
+#include <hayai.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <aisdi/Hash.hpp>
+#include <aisdi/HashMap.hpp>
+
+constexpr auto Size = 100000;
+
+// Keys of URL-like length, looked up in random order
+template<typename Hash>
+class StringKeysBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        keys.clear();
+        for(auto i = 0; i < Size; ++i)
+        {
+            keys.push_back("https://example.com/items/" + std::to_string(rand()));
+        }
+        container = aisdi::HashMap<std::string, int, Hash>{};
+    }
+
+    void insert()
+    {
+        for(const auto& key : keys)
+        {
+            container[key] = 1;
+        }
+    }
+
+    void find()
+    {
+        for(const auto& key : keys)
+        {
+            container.find(key);
+        }
+    }
+
+    std::vector<std::string> keys;
+    aisdi::HashMap<std::string, int, Hash> container;
+};
+
+using StdStringKeysBenchmark = StringKeysBenchmark<std::hash<std::string>>;
+using WyhashStringKeysBenchmark = StringKeysBenchmark<aisdi::StringHash>;
+
+BENCHMARK_F(StdStringKeysBenchmark, InsertTest, 10, 1)
+{
+    insert();
+}
+
+BENCHMARK_F(WyhashStringKeysBenchmark, InsertTest, 10, 1)
+{
+    insert();
+}
+
+BENCHMARK_F(StdStringKeysBenchmark, InsertAndFindTest, 10, 1)
+{
+    insert();
+    find();
+}
+
+BENCHMARK_F(WyhashStringKeysBenchmark, InsertAndFindTest, 10, 1)
+{
+    insert();
+    find();
+}
+
+// Keys being multiples of a power of two, as addresses or ids with flags
+// in low bits. Identity std::hash puts them into few buckets of the
+// default ModuloBucketPolicy, while mixed hashes spread them evenly.
+template<typename Hash>
+class StridedKeysBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        container = aisdi::HashMap<std::uint64_t, int, Hash>{};
+    }
+
+    void insertAndFind()
+    {
+        for(std::uint64_t i = 0; i < Size / 10; ++i)
+        {
+            container[i << 10] = 1;
+        }
+
+        for(std::uint64_t i = 0; i < Size / 10; ++i)
+        {
+            container.find(i << 10);
+        }
+    }
+
+    aisdi::HashMap<std::uint64_t, int, Hash> container;
+};
+
+using StdStridedKeysBenchmark = StridedKeysBenchmark<std::hash<std::uint64_t>>;
+using MixedStridedKeysBenchmark = StridedKeysBenchmark<aisdi::IntegerHash<std::uint64_t>>;
+
+BENCHMARK_F(StdStridedKeysBenchmark, InsertAndFindTest, 10, 1)
+{
+    insertAndFind();
+}
+
+BENCHMARK_F(MixedStridedKeysBenchmark, InsertAndFindTest, 10, 1)
+{
+    insertAndFind();
+}
+
+// Random keys, for which identity hash is already good, so it shows
+// the price of mixing
+template<typename Hash>
+class RandomKeysBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        keys.clear();
+        for(auto i = 0; i < Size; ++i)
+        {
+            keys.push_back(static_cast<std::uint64_t>(rand()) * 7919u);
+        }
+        container = aisdi::HashMap<std::uint64_t, int, Hash>{};
+    }
+
+    void insertAndFind()
+    {
+        for(auto key : keys)
+        {
+            container[key] = 1;
+        }
+
+        for(auto key : keys)
+        {
+            container.find(key);
+        }
+    }
+
+    std::vector<std::uint64_t> keys;
+    aisdi::HashMap<std::uint64_t, int, Hash> container;
+};
+
+using StdRandomKeysBenchmark = RandomKeysBenchmark<std::hash<std::uint64_t>>;
+using MixedRandomKeysBenchmark = RandomKeysBenchmark<aisdi::IntegerHash<std::uint64_t>>;
+
+BENCHMARK_F(StdRandomKeysBenchmark, InsertAndFindTest, 10, 1)
+{
+    insertAndFind();
+}
+
+BENCHMARK_F(MixedRandomKeysBenchmark, InsertAndFindTest, 10, 1)
+{
+    insertAndFind();
+}
@@ -1,6 +1,10 @@
 #include <hayai.hpp>
 
+#include <algorithm>
 #include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include <aisdi/HashMap.hpp>
 
@@ -18,6 +22,24 @@ BENCHMARK_F(InsertionBenchmark, AccessTest, 10, Iterations)
     container[rand() % 1000000000] = (rand() % 10000);
 }
 
+// Growth moves a few buckets per insertion instead of the whole table
+class IncrementalInsertionBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        container.incremental_rehash(true);
+    }
+
+    aisdi::HashMap<int, int> container;
+};
+
+BENCHMARK_F(IncrementalInsertionBenchmark, AccessTest, 10, Iterations)
+{
+    container[rand() % 1000000000] = (rand() % 10000);
+}
+
 class ErasingBenchmark
     :   public ::hayai::Fixture
 {
@@ -64,6 +86,43 @@ BENCHMARK_F(CopyingBenchmark, CopyConstructorTest, 100, 1)
     static_cast<void>(other);
 }
 
+// Moves all items of one map to another one, as when rebalancing shards
+class MovingItemsBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    constexpr static auto Size = 100000;
+
+    void SetUp() override
+    {
+        source = Map{};
+        target = Map{};
+        for(auto i = 0; i < Size; ++i)
+        {
+            source.insert({std::to_string(i), std::string(32, 'x')});
+        }
+    }
+
+    using Map = aisdi::HashMap<std::string, std::string>;
+
+    Map source;
+    Map target;
+};
+
+BENCHMARK_F(MovingItemsBenchmark, CopyAndEraseTest, 10, 1)
+{
+    while(!source.empty())
+    {
+        target.insert(*source.begin());
+        source.erase(source.begin());
+    }
+}
+
+BENCHMARK_F(MovingItemsBenchmark, MergeTest, 10, 1)
+{
+    target.merge(source);
+}
+
 class SearchingBenchmark
     :   public ::hayai::Fixture
 {
@@ -106,3 +165,140 @@ BENCHMARK_F(ComparingBenchmark, EqualityTest, 1000, 1)
     const auto equals = (container == other);
     static_cast<void>(equals);
 }
+
+// Equal maps filled in different orders, so their iteration orders differ
+class EqualMapsComparingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        auto keys = std::vector<int>{};
+        for(auto i = 0; i < Iterations; ++i)
+        {
+            keys.push_back(rand() % 1000000000);
+        }
+
+        for(auto key : keys)
+        {
+            container[key] = key % 10000;
+        }
+
+        for(auto pos = keys.rbegin(); pos != keys.rend(); ++pos)
+        {
+            sameBuckets[*pos] = *pos % 10000;
+            otherBuckets[*pos] = *pos % 10000;
+        }
+        otherBuckets.rehash(container.bucket_count() + 1);
+    }
+
+    aisdi::HashMap<int, int> container;
+    aisdi::HashMap<int, int> sameBuckets;
+    aisdi::HashMap<int, int> otherBuckets;
+};
+
+BENCHMARK_F(EqualMapsComparingBenchmark, SameBucketCountTest, 1000, 1)
+{
+    const auto equals = (container == sameBuckets);
+    static_cast<void>(equals);
+}
+
+BENCHMARK_F(EqualMapsComparingBenchmark, DifferentBucketCountTest, 1000, 1)
+{
+    const auto equals = (container == otherBuckets);
+    static_cast<void>(equals);
+}
+
+template<typename BucketPolicy>
+class SequentialKeysBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        for(auto i = 0u; i < Iterations; ++i)
+        {
+            container[i] = (rand() % 10000);
+        }
+    }
+
+    aisdi::HashMap<unsigned, int,
+                   std::hash<unsigned>,
+                   std::equal_to<unsigned>,
+                   BucketPolicy> container;
+};
+
+using ModuloSequentialKeysBenchmark = SequentialKeysBenchmark<aisdi::ModuloBucketPolicy>;
+using FibonacciSequentialKeysBenchmark = SequentialKeysBenchmark<aisdi::FibonacciBucketPolicy>;
+
+BENCHMARK_F(ModuloSequentialKeysBenchmark, FindTest, 100, Iterations)
+{
+    container.find(static_cast<unsigned>(rand()) % Iterations);
+}
+
+BENCHMARK_F(FibonacciSequentialKeysBenchmark, FindTest, 100, Iterations)
+{
+    container.find(static_cast<unsigned>(rand()) % Iterations);
+}
+
+// Table much larger than processor caches and fresh keys in every
+// iteration, so nearly every lookup misses
+class LargeMapSearchingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    constexpr static auto Size = 1 << 22;
+    constexpr static auto BatchSize = 256;
+    constexpr static auto Batches = 100;
+
+    void SetUp() override
+    {
+        container();
+        keys.clear();
+        for(auto i = 0; i < BatchSize * Batches; ++i)
+        {
+            keys.push_back(rand() % (2 * Size));
+        }
+        batch = keys.begin();
+        found.clear();
+        found.reserve(BatchSize);
+    }
+
+    static const aisdi::HashMap<int, int>& container()
+    {
+        static const auto map = []
+            {
+                auto map = aisdi::HashMap<int, int>{};
+                map.reserve(Size);
+                for(auto i = 0; i < Size; ++i)
+                {
+                    map[rand() % (2 * Size)] = i;
+                }
+                return map;
+            }();
+        return map;
+    }
+
+    std::vector<int> keys;
+    std::vector<int>::const_iterator batch;
+    std::vector<aisdi::HashMap<int, int>::const_iterator> found;
+};
+
+BENCHMARK_F(LargeMapSearchingBenchmark, RepeatedFindTest, 10, LargeMapSearchingBenchmark::Batches)
+{
+    found.clear();
+    const auto& map = container();
+    std::for_each(batch, batch + BatchSize,
+                  [this, &map](auto key)
+                  {
+                      found.push_back(map.find(key));
+                  });
+    batch += BatchSize;
+}
+
+BENCHMARK_F(LargeMapSearchingBenchmark, FindManyTest, 10, LargeMapSearchingBenchmark::Batches)
+{
+    found.clear();
+    container().find_many(batch, batch + BatchSize, std::back_inserter(found));
+    batch += BatchSize;
+}
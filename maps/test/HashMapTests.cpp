@@ -1,7 +1,10 @@
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <iterator>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -857,6 +860,719 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_Th
   BOOST_CHECK(map != other);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsWithDifferentBucketCounts_WhenComparingThem_ThenOnlyItemsMatter,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+  Map<K> other = { { 13, "Chuck" }, { 27, "Bob" }, { 42, "Alice" } };
+  other.rehash(101);
+  BOOST_REQUIRE(map.bucket_count() != other.bucket_count());
+
+  BOOST_CHECK(map == other);
+  BOOST_CHECK(other == map);
+
+  other[K(27)] = "Alice";
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapsWithDifferentHistories_WhenComparingThem_ThenTheyAreEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  Map<K> other;
+  for (int i = 0; i < 100; ++i)
+  {
+    map[K(i)] = std::to_string(i);
+    other[K(99 - i)] = std::to_string(99 - i);
+    other[K(100 + i)] = "Bob";
+  }
+  for (int i = 100; i < 200; ++i)
+  {
+    other.erase(K(i));
+  }
+  other.rehash(map.bucket_count());
+  BOOST_REQUIRE(map.bucket_count() == other.bucket_count());
+
+  BOOST_CHECK(map == other);
+
+  other.erase(K(42));
+  other[K(200)] = "42";
+  BOOST_CHECK(map != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenRehashing_ThenAllItemsAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+
+  map.rehash(101);
+
+  BOOST_CHECK(map.bucket_count() >= 101);
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenRehashingBelowLoadFactor_ThenBucketCountIsKeptAboveSize,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+
+  map.rehash(1);
+
+  BOOST_CHECK(map.load_factor() <= map.max_load_factor());
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenInsertingManyItems_ThenLoadFactorIsNotExceeded,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    map[K(i)] = std::to_string(i);
+    expected[K(i)] = std::to_string(i);
+    BOOST_REQUIRE(map.load_factor() <= map.max_load_factor());
+  }
+
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenReservingSpace_ThenItemsMayBeInsertedWithoutRehashing,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  map.reserve(100);
+  const auto bucketCount = map.bucket_count();
+
+  for (int i = 0; i < 100; ++i)
+  {
+    map[K(i)] = "Alice";
+  }
+
+  BOOST_CHECK(map.bucket_count() == bucketCount);
+  BOOST_CHECK(map.size() == 100);
+}
+
+namespace
+{
+
+struct CountingHash
+{
+  std::size_t operator()(const std::string& key) const
+  {
+    ++calls;
+    return std::hash<std::string>()(key);
+  }
+
+  static std::size_t calls;
+};
+
+std::size_t CountingHash::calls = 0;
+
+struct CollidingHash
+{
+  std::size_t operator()(const std::string& key) const
+  {
+    // Hashes differ, but all keys land in the same bucket of 10
+    return key.size() * 10;
+  }
+};
+
+struct CountingKeyEqual
+{
+  bool operator()(const std::string& lhs, const std::string& rhs) const
+  {
+    ++calls;
+    return lhs == rhs;
+  }
+
+  static std::size_t calls;
+};
+
+std::size_t CountingKeyEqual::calls = 0;
+
+// Key, which counts its constructions
+struct Name
+{
+  Name(const char* value_)
+    : value(value_)
+  {
+    ++created;
+  }
+
+  std::string value;
+
+  static std::size_t created;
+};
+
+std::size_t Name::created = 0;
+
+const char* chars(const Name& name)
+{
+  return name.value.c_str();
+}
+
+const char* chars(const char* name)
+{
+  return name;
+}
+
+struct TransparentNameHash
+{
+  using is_transparent = void;
+
+  template <typename K>
+  std::size_t operator()(const K& key) const
+  {
+    // FNV-1a
+    auto hash = std::size_t{14695981039346656037ull};
+    for (auto c = chars(key); *c != '\0'; ++c)
+    {
+      hash = (hash ^ static_cast<unsigned char>(*c)) * std::size_t{1099511628211ull};
+    }
+    return hash;
+  }
+};
+
+struct TransparentNameEqual
+{
+  using is_transparent = void;
+
+  template <typename L, typename R>
+  bool operator()(const L& lhs, const R& rhs) const
+  {
+    return std::strcmp(chars(lhs), chars(rhs)) == 0;
+  }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(GivenStringKeys_WhenRehashing_ThenHashesAreNotRecomputed)
+{
+  static_assert(aisdi::IsHashCached<std::string, CountingHash>::value,
+                "Hashes of strings should be cached");
+
+  aisdi::HashMap<std::string, int, CountingHash> map;
+  for (int i = 0; i < 100; ++i)
+  {
+    map[std::to_string(i)] = i;
+  }
+
+  CountingHash::calls = 0;
+  map.rehash(1000);
+
+  BOOST_CHECK(CountingHash::calls == 0);
+  BOOST_CHECK(map.at("42") == 42);
+}
+
+BOOST_AUTO_TEST_CASE(GivenKeysInSameBucket_WhenSearching_ThenOnlyKeysWithSameHashAreCompared)
+{
+  aisdi::HashMap<std::string, int, CollidingHash, CountingKeyEqual> map;
+  map["a"] = 1;
+  map["bb"] = 2;
+  map["ccc"] = 3;
+  BOOST_REQUIRE(map.bucket("a") == map.bucket("ccc"));
+
+  CountingKeyEqual::calls = 0;
+  const auto pos = map.find("ccc");
+
+  BOOST_REQUIRE(pos != map.end());
+  BOOST_CHECK(pos->second == 3);
+  BOOST_CHECK(CountingKeyEqual::calls == 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenKeysInSameBucket_WhenComparingMaps_ThenKeysAreNeitherHashedNorComparedIfHashesDiffer)
+{
+  aisdi::HashMap<std::string, int, CountingHash, CountingKeyEqual> map;
+  aisdi::HashMap<std::string, int, CountingHash, CountingKeyEqual> other;
+  for (int i = 0; i < 100; ++i)
+  {
+    map[std::to_string(i)] = i;
+    other[std::to_string(99 - i)] = 99 - i;
+  }
+  BOOST_REQUIRE(map.bucket_count() == other.bucket_count());
+
+  CountingHash::calls = 0;
+  CountingKeyEqual::calls = 0;
+
+  BOOST_CHECK(map == other);
+  BOOST_CHECK(CountingHash::calls == 0);
+  BOOST_CHECK(CountingKeyEqual::calls == 100);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTransparentHashAndKeyEqual_WhenLookingUpByOtherType_ThenNoKeyIsConstructed)
+{
+  aisdi::HashMap<Name, int, TransparentNameHash, TransparentNameEqual> map;
+  map[Name("Alice")] = 1;
+  map[Name("Bob")] = 2;
+  map[Name("Chuck")] = 3;
+  Name::created = 0;
+
+  BOOST_REQUIRE(map.find("Bob") != map.end());
+  BOOST_CHECK(map.find("Bob")->second == 2);
+  BOOST_CHECK(map.find("Dave") == map.end());
+  BOOST_CHECK(map.contains("Alice"));
+  BOOST_CHECK(map.count("Chuck") == 1);
+  BOOST_CHECK(map.count("Dave") == 0);
+  BOOST_CHECK(map.at("Chuck") == 3);
+  BOOST_CHECK_THROW(map.at("Dave"), std::out_of_range);
+
+  const auto& constMap = map;
+  BOOST_CHECK(constMap.find("Alice")->second == 1);
+  BOOST_CHECK(constMap.at("Alice") == 1);
+
+  BOOST_CHECK(map.erase("Alice") == 1);
+  BOOST_CHECK(map.erase("Alice") == 0);
+  BOOST_CHECK(Name::created == 0);
+
+  map.erase(map.begin());
+  BOOST_CHECK(map.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenFindingManyKeys_ThenEachKeyIsResolvedInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 100; i += 2)
+  {
+    map[K(i)] = std::to_string(i);
+  }
+
+  std::vector<K> keys;
+  for (int i = 99; i >= 0; --i)
+  {
+    keys.push_back(K(i));
+  }
+
+  std::vector<typename Map<K>::iterator> found;
+  map.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+
+  BOOST_REQUIRE(found.size() == keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    BOOST_CHECK(found[i] == map.find(keys[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenConstMap_WhenFindingManyKeys_ThenConstIteratorsAreWritten)
+{
+  const Map<std::int32_t> map = { { 42, "Alice" }, { 27, "Bob" } };
+  const std::int32_t keys[] = { 27, 13, 42 };
+
+  typename Map<std::int32_t>::const_iterator found[3];
+  const auto last = map.find_many(std::begin(keys), std::end(keys), found);
+
+  BOOST_CHECK(last == std::end(found));
+  BOOST_CHECK(found[0]->second == "Bob");
+  BOOST_CHECK(found[1] == map.end());
+  BOOST_CHECK(found[2]->second == "Alice");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIncrementalMap_WhenGrowing_ThenItemsAreMovedGradually,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(16);
+  map.incremental_rehash(true);
+  BOOST_CHECK(map.incremental_rehash());
+
+  auto sawRehashing = false;
+  for (int i = 0; i < 1000; ++i)
+  {
+    map[K(i)] = std::to_string(i);
+    sawRehashing = sawRehashing || map.rehashing();
+
+    BOOST_REQUIRE(map.size() == static_cast<std::size_t>(i + 1));
+    BOOST_REQUIRE(std::distance(map.begin(), map.end()) == i + 1);
+    for (int j = 0; j <= i; j += 7)
+    {
+      BOOST_REQUIRE(map.contains(K(j)));
+    }
+  }
+
+  BOOST_CHECK(sawRehashing);
+  for (int i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(map.at(K(i)) == std::to_string(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapBeingRehashed_WhenErasingCopyingAndMoving_ThenItemsAreKept,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(16);
+  map.incremental_rehash(true);
+  auto count = 0;
+  while (!map.rehashing() || map.size() < 200)
+  {
+    map[K(count)] = std::to_string(count);
+    ++count;
+  }
+
+  for (int i = 0; i < count; i += 3)
+  {
+    BOOST_REQUIRE(map.erase(K(i)) == 1);
+  }
+
+  const auto copy = map;
+  BOOST_CHECK(copy == map);
+
+  auto moved = std::move(map);
+  BOOST_CHECK(moved == copy);
+
+  moved[K(count)] = "Alice";
+  moved.rehash(4096);
+  BOOST_CHECK(!moved.rehashing());
+  for (int i = 0; i < count; ++i)
+  {
+    BOOST_CHECK(copy.contains(K(i)) == (i % 3 != 0));
+    BOOST_CHECK(moved.contains(K(i)) == (i % 3 != 0));
+  }
+  BOOST_CHECK(moved.at(K(count)) == "Alice");
+  BOOST_CHECK(std::distance(copy.begin(), copy.end()) == static_cast<std::ptrdiff_t>(copy.size()));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSparseMap_WhenIterating_ThenOnlyItemsAreVisited,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+  map.rehash(100000);
+
+  const auto first = map.begin();
+  BOOST_REQUIRE(first != map.end());
+  BOOST_CHECK(std::next(first, 2) == map.end());
+  BOOST_CHECK(std::prev(map.end(), 2) == first);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenErasingWhileIterating_ThenEveryItemIsVisitedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 100; ++i)
+  {
+    map[K(i)] = std::to_string(i);
+  }
+
+  std::map<K, std::string> visited;
+  for (auto pos = map.begin(); pos != map.end();)
+  {
+    BOOST_REQUIRE(visited.count(pos->first) == 0);
+    visited[pos->first] = pos->second;
+    pos = (static_cast<int>(pos->first) % 3 == 0) ? map.erase(pos) : std::next(pos);
+  }
+
+  BOOST_CHECK(visited.size() == 100);
+  BOOST_CHECK(map.size() == 66);
+  for (const auto& item : map)
+  {
+    BOOST_CHECK(static_cast<int>(item.first) % 3 != 0);
+    BOOST_CHECK(map.at(item.first) == item.second);
+  }
+}
+
+using BucketPolicies = boost::mpl::list<aisdi::ModuloBucketPolicy,
+                                        aisdi::FibonacciBucketPolicy,
+                                        aisdi::AvalancheBucketPolicy>;
+
+using PowerOfTwoBucketPolicies = boost::mpl::list<aisdi::FibonacciBucketPolicy,
+                                                  aisdi::AvalancheBucketPolicy>;
+
+template <typename Policy>
+using PolicyMap = aisdi::HashMap<std::uint32_t, std::string,
+                                 std::hash<std::uint32_t>,
+                                 std::equal_to<std::uint32_t>,
+                                 Policy>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBucketPolicy_WhenInsertingAndErasingItems_ThenMapStaysConsistent,
+                              Policy,
+                              BucketPolicies)
+{
+  PolicyMap<Policy> map;
+  for (std::uint32_t i = 0; i < 1000; ++i)
+  {
+    map[i] = std::to_string(i);
+  }
+
+  for (std::uint32_t i = 0; i < 1000; i += 2)
+  {
+    map.erase(i);
+  }
+
+  BOOST_CHECK(map.size() == 500);
+  BOOST_CHECK(std::distance(map.begin(), map.end()) == 500);
+  for (std::uint32_t i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(map.contains(i) == (i % 2 == 1));
+  }
+
+  BOOST_CHECK(map.at(777) == "777");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenPowerOfTwoPolicy_WhenRehashing_ThenBucketCountIsPowerOfTwo,
+                              Policy,
+                              PowerOfTwoBucketPolicies)
+{
+  PolicyMap<Policy> map(10);
+  BOOST_CHECK(map.bucket_count() == 16);
+
+  map.rehash(100);
+  BOOST_CHECK(map.bucket_count() == 128);
+
+  for (std::uint32_t i = 0; i < 1000; ++i)
+  {
+    map[i] = "Alice";
+  }
+
+  const auto bucketCount = map.bucket_count();
+  BOOST_CHECK((bucketCount & (bucketCount - 1)) == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenPowerOfTwoPolicy_WhenInsertingStridedKeys_ThenTheyAreSpreadEvenly,
+                              Policy,
+                              PowerOfTwoBucketPolicies)
+{
+  // Identity hashes of multiples of bucket count would share one bucket
+  // if they were simply masked
+  PolicyMap<Policy> map;
+  map.reserve(1024);
+  const auto bucketCount = static_cast<std::uint32_t>(map.bucket_count());
+  for (std::uint32_t i = 0; i < 1024; ++i)
+  {
+    map[i * bucketCount] = "Alice";
+  }
+
+  BOOST_REQUIRE(map.bucket_count() == bucketCount);
+  auto longestChain = std::size_t{0};
+  for (std::size_t bucket = 0; bucket < map.bucket_count(); ++bucket)
+  {
+    longestChain = std::max(longestChain, map.bucket_size(bucket));
+  }
+
+  BOOST_CHECK(longestChain <= 8);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenExtractingKey_ThenNodeHoldsItsItem,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  auto node = map.extract(42);
+
+  BOOST_REQUIRE(!node.empty());
+  BOOST_CHECK(node.key() == K{42});
+  BOOST_CHECK(node.mapped() == "Alice");
+  BOOST_CHECK(!map.contains(42));
+  BOOST_CHECK(map.size() == 1);
+  BOOST_CHECK(map.extract(13).empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenExtractedNode_WhenInsertingIntoOtherMap_ThenItemIsNotCopied,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+  Map<K> other;
+  auto node = map.extract(map.find(27));
+  OperationCountingObject::resetCounters();
+
+  const auto result = other.insert(std::move(node));
+
+  BOOST_CHECK(result.inserted);
+  BOOST_CHECK(result.node.empty());
+  BOOST_REQUIRE(result.position != other.end());
+  BOOST_CHECK(result.position->second == "Bob");
+  BOOST_CHECK(other.size() == 1);
+  thenConstructedObjectsCountWas<K>(0);
+  thenDestroyedObjectsCountWas<K>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNodeWithPresentKey_WhenInsertingIt_ThenNodeIsGivenBack,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+  Map<K> other = { { 42, "Bob" } };
+
+  const auto result = map.insert(other.extract(42));
+
+  BOOST_CHECK(!result.inserted);
+  BOOST_REQUIRE(!result.node.empty());
+  BOOST_CHECK(result.node.mapped() == "Bob");
+  BOOST_CHECK(result.position->second == "Alice");
+  BOOST_CHECK(map.size() == 1);
+  BOOST_CHECK(other.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMaps_WhenMerging_ThenOnlyMissingKeysAreMoved,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  Map<K> other;
+  for (int i = 0; i < 100; ++i)
+  {
+    map[K(i)] = "Alice";
+    other[K(i + 50)] = "Bob";
+  }
+  OperationCountingObject::resetCounters();
+
+  map.merge(other);
+
+  BOOST_CHECK(map.size() == 150);
+  BOOST_CHECK(other.size() == 50);
+  for (int i = 0; i < 150; ++i)
+  {
+    BOOST_CHECK(map.at(K(i)) == (i < 100 ? "Alice" : "Bob"));
+    BOOST_CHECK(other.contains(K(i)) == (i >= 50 && i < 100));
+  }
+  thenCopiedObjectsCountWas<K>(0);
+  thenMovedObjectsCountWas<K>(0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRehashingMap_WhenMergingIntoOther_ThenAllItemsAreFound)
+{
+  Map<std::string> map;
+  Map<std::string> other(1);
+  map.incremental_rehash(true);
+  other.incremental_rehash(true);
+  for (int i = 0; i < 100; ++i)
+  {
+    map[std::to_string(i)] = "Alice";
+    other[std::to_string(i + 50)] = "Bob";
+  }
+
+  other.merge(map);
+
+  BOOST_CHECK(other.size() == 150);
+  BOOST_CHECK(map.size() == 50);
+  for (int i = 0; i < 150; ++i)
+  {
+    BOOST_CHECK(other.at(std::to_string(i)) == (i < 50 ? "Alice" : "Bob"));
+  }
+  for (int i = 50; i < 100; ++i)
+  {
+    BOOST_CHECK(map.at(std::to_string(i)) == "Alice");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyMap_WhenTakingStats_ThenAllBucketsAreEmpty)
+{
+  const Map<std::int32_t> map;
+
+  const auto stats = map.stats();
+
+  BOOST_CHECK(stats.size == 0);
+  BOOST_CHECK(stats.bucketCount == map.bucket_count());
+  BOOST_CHECK(stats.sampledBuckets == map.bucket_count());
+  BOOST_REQUIRE(stats.bucketSizes.size() == 1);
+  BOOST_CHECK(stats.bucketSizes[0] == map.bucket_count());
+  BOOST_CHECK(stats.maxChainLength == 0);
+  BOOST_CHECK(stats.emptyBucketRatio == 1.0);
+  BOOST_CHECK(stats.meanSuccessfulProbes == 0.0);
+  BOOST_CHECK(stats.meanUnsuccessfulProbes == 0.0);
+  BOOST_CHECK(stats.memoryBytes == map.memory_bytes());
+  BOOST_CHECK(stats.memoryBytes >= sizeof(map));
+}
+
+BOOST_AUTO_TEST_CASE(GivenKeysInOneBucket_WhenTakingStats_ThenChainLengthsAreReported)
+{
+  aisdi::HashMap<std::string, int, CollidingHash> map(10);
+  for (const auto key : {"a", "b", "c", "d", "e"})
+  {
+    map[key] = 1;
+  }
+  BOOST_REQUIRE(map.bucket_count() == 10);
+
+  const auto stats = map.stats();
+
+  BOOST_CHECK(stats.size == 5);
+  BOOST_REQUIRE(stats.bucketSizes.size() == 6);
+  BOOST_CHECK(stats.bucketSizes[0] == 9);
+  BOOST_CHECK(stats.bucketSizes[5] == 1);
+  BOOST_CHECK(stats.maxChainLength == 5);
+  BOOST_CHECK_CLOSE(stats.emptyBucketRatio, 0.9, 1e-9);
+  BOOST_CHECK_CLOSE(stats.meanSuccessfulProbes, 3.0, 1e-9);
+  BOOST_CHECK_CLOSE(stats.meanUnsuccessfulProbes, 0.5, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenTakingStats_ThenHistogramMatchesBuckets,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (int i = 0; i < 1000; ++i)
+  {
+    map[K(i * 3)] = "Alice";
+  }
+
+  const auto stats = map.stats();
+
+  auto expected = std::vector<std::size_t>(stats.maxChainLength + 1);
+  for (std::size_t bucket = 0; bucket < map.bucket_count(); ++bucket)
+  {
+    BOOST_REQUIRE(map.bucket_size(bucket) < expected.size());
+    ++expected[map.bucket_size(bucket)];
+  }
+  BOOST_CHECK(stats.bucketSizes == expected);
+  BOOST_CHECK(expected.back() > 0);
+  BOOST_CHECK_CLOSE(stats.emptyBucketRatio,
+                    static_cast<double>(expected.front()) / static_cast<double>(map.bucket_count()),
+                    1e-9);
+  BOOST_CHECK_CLOSE(stats.meanUnsuccessfulProbes, static_cast<double>(map.load_factor()), 1e-3);
+  BOOST_CHECK(stats.meanSuccessfulProbes >= 1.0);
+  BOOST_CHECK(stats.memoryBytes > Map<K>().memory_bytes());
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapBeingRehashed_WhenTakingStats_ThenItemsOfBothTablesAreCounted)
+{
+  Map<std::string> map(16);
+  map.incremental_rehash(true);
+  for (int i = 0; i < 17; ++i)
+  {
+    map[std::to_string(i)] = "Alice";
+  }
+  BOOST_REQUIRE(map.rehashing());
+
+  const auto stats = map.stats();
+
+  auto items = std::size_t{0};
+  for (std::size_t length = 0; length < stats.bucketSizes.size(); ++length)
+  {
+    items += length * stats.bucketSizes[length];
+  }
+  BOOST_CHECK(items == map.size());
+  BOOST_CHECK(stats.sampledBuckets > map.bucket_count());
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeMap_WhenSamplingStats_ThenOnlyFewBucketsAreRead)
+{
+  Map<std::uint64_t> map;
+  for (std::uint64_t i = 0; i < 10000; ++i)
+  {
+    map[i] = "Alice";
+  }
+
+  const auto stats = map.stats(100);
+
+  BOOST_CHECK(stats.sampledBuckets >= 100);
+  BOOST_CHECK(stats.sampledBuckets <= 110);
+  BOOST_CHECK(stats.size == map.size());
+  BOOST_CHECK(stats.bucketCount == map.bucket_count());
+  BOOST_CHECK(stats.memoryBytes == map.memory_bytes());
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
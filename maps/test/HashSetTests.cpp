@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/HashSet.hpp"
+
+template <typename K>
+using Set = aisdi::HashSet<K>;
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::string>;
+
+namespace
+{
+
+template <typename K>
+K key(int value)
+{
+  return static_cast<K>(value);
+}
+
+template <>
+std::string key<std::string>(int value)
+{
+  return std::to_string(value);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(HashSetTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptySet_WhenInsertingKey_ThenItIsReportedAsNew,
+                              K,
+                              TestedKeyTypes)
+{
+  Set<K> set;
+
+  const auto result = set.insert(key<K>(42));
+
+  BOOST_CHECK(result.second);
+  BOOST_CHECK(*result.first == key<K>(42));
+  BOOST_CHECK(set.contains(key<K>(42)));
+  BOOST_CHECK(set.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSetWithKey_WhenInsertingItAgain_ThenExistingKeyIsReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  Set<K> set;
+  const auto pos = set.insert(key<K>(42)).first;
+
+  const auto result = set.insert(key<K>(42));
+
+  BOOST_CHECK(!result.second);
+  BOOST_CHECK(result.first == pos);
+  BOOST_CHECK(set.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyKeys_WhenInsertingThem_ThenEachIsIteratedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Set<K> set;
+  for (int i = 0; i < 100; ++i)
+  {
+    set.insert(key<K>(i % 50));
+  }
+
+  std::vector<int> seen(50);
+  for (const auto& item : set)
+  {
+    for (int i = 0; i < 50; ++i)
+    {
+      seen[static_cast<std::size_t>(i)] += (item == key<K>(i)) ? 1 : 0;
+    }
+  }
+
+  BOOST_CHECK(set.size() == 50);
+  BOOST_CHECK(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenErasingKey_ThenItIsNoLongerFound,
+                              K,
+                              TestedKeyTypes)
+{
+  Set<K> set{key<K>(1), key<K>(2), key<K>(3)};
+
+  BOOST_CHECK(set.erase(key<K>(2)) == 1);
+  BOOST_CHECK(set.erase(key<K>(2)) == 0);
+  BOOST_CHECK(!set.contains(key<K>(2)));
+  BOOST_CHECK(set.find(key<K>(2)) == set.end());
+  BOOST_CHECK(set.count(key<K>(3)) == 1);
+  BOOST_CHECK(set.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSetsWithSameKeys_WhenComparing_ThenTheyAreEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  Set<K> set{key<K>(1), key<K>(2), key<K>(3)};
+  Set<K> other(100);
+  other.insert(key<K>(3));
+  other.insert(key<K>(1));
+  other.insert(key<K>(2));
+
+  BOOST_CHECK(set == other);
+  other.erase(key<K>(1));
+  other.insert(key<K>(4));
+  BOOST_CHECK(set != other);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenCopying_ThenCopyHasSameKeys,
+                              K,
+                              TestedKeyTypes)
+{
+  Set<K> set{key<K>(1), key<K>(2), key<K>(3)};
+
+  const Set<K> copy{set};
+  set.insert(key<K>(4));
+
+  BOOST_CHECK(copy.size() == 3);
+  BOOST_CHECK(copy.contains(key<K>(1)) && copy.contains(key<K>(2)) && copy.contains(key<K>(3)));
+  BOOST_CHECK(!copy.contains(key<K>(4)));
+}
+
+BOOST_AUTO_TEST_CASE(GivenIntegerKeys_WhenStoringThemInSet_ThenNodeKeepsNoMappedValue)
+{
+  using SetNode = Set<std::uint32_t>::Node;
+  using MapNode = aisdi::HashMap<std::uint32_t, char>::Node;
+
+  BOOST_CHECK(sizeof(SetNode) == sizeof(std::uint32_t));
+  BOOST_CHECK(sizeof(SetNode) < sizeof(MapNode));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
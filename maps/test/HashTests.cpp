@@ -0,0 +1,177 @@
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "aisdi/Hash.hpp"
+#include "aisdi/HashMap.hpp"
+#include "aisdi/HashSet.hpp"
+
+using aisdi::IntegerHash;
+using aisdi::StringHash;
+
+namespace
+{
+
+int changedBits(std::uint64_t lhs, std::uint64_t rhs)
+{
+  return static_cast<int>(std::bitset<64>(lhs ^ rhs).count());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(HashTests)
+
+BOOST_AUTO_TEST_CASE(GivenSameSeed_WhenHashingString_ThenHashesAreEqual)
+{
+  const StringHash hash(42);
+  const StringHash other(42);
+
+  BOOST_CHECK(hash("Alice") == other("Alice"));
+  BOOST_CHECK(hash(std::string("Alice")) == hash("Alice"));
+  BOOST_CHECK(hash("Alice") != hash("Alicf"));
+}
+
+BOOST_AUTO_TEST_CASE(GivenDifferentSeeds_WhenHashingString_ThenHashesDiffer)
+{
+  const StringHash hash(42);
+  const StringHash other(43);
+
+  BOOST_CHECK(hash("Alice") != other("Alice"));
+  BOOST_CHECK(hash("") != other(""));
+}
+
+BOOST_AUTO_TEST_CASE(GivenDefaultHashers_WhenConstructing_ThenEachOneHasOwnSeed)
+{
+  const StringHash hash;
+  const StringHash other;
+  const auto copy = hash;
+
+  BOOST_CHECK(hash.seed() != other.seed());
+  BOOST_CHECK(copy.seed() == hash.seed());
+  BOOST_CHECK(IntegerHash<int>{}.seed() != IntegerHash<int>{}.seed());
+}
+
+BOOST_AUTO_TEST_CASE(GivenBytesOfEveryLength_WhenHashing_ThenOnlyGivenBytesAreRead)
+{
+  auto text = std::string(200, 'x');
+  auto hashes = std::set<std::uint64_t>{};
+  for (auto size = 0u; size <= 100; ++size)
+  {
+    const auto hash = aisdi::hashBytes(text.data() + 50, size, 42);
+    text[49] = 'y';
+    text[50 + size] = 'y';
+    BOOST_CHECK(aisdi::hashBytes(text.data() + 50, size, 42) == hash);
+    text[49] = 'x';
+    text[50 + size] = 'x';
+
+    hashes.insert(hash);
+  }
+
+  BOOST_CHECK(hashes.size() == 101);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLongString_WhenChangingAnyByte_ThenHashChanges)
+{
+  const StringHash hash(42);
+  auto text = std::string(150, 'x');
+  const auto original = hash(text);
+
+  for (auto& c : text)
+  {
+    c = 'y';
+    BOOST_CHECK(hash(text) != original);
+    c = 'x';
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenIntegerHash_WhenFlippingSingleBit_ThenAboutHalfOfHashChanges)
+{
+  const IntegerHash<std::uint64_t> hash(42);
+  auto total = 0;
+  for (auto bit = 0u; bit < 64; ++bit)
+  {
+    const auto value = UINT64_C(0x0123456789ABCDEF);
+    const auto changed = changedBits(hash(value), hash(value ^ (UINT64_C(1) << bit)));
+    BOOST_CHECK(changed > 8);
+    total += changed;
+  }
+
+  BOOST_CHECK(total > 64 * 24);
+  BOOST_CHECK(total < 64 * 40);
+}
+
+BOOST_AUTO_TEST_CASE(GivenIntegerHash_WhenHashingSequentialKeys_ThenLowBitsAreSpread)
+{
+  const IntegerHash<std::uint32_t> hash(42);
+  auto buckets = std::vector<int>(16, 0);
+  for (std::uint32_t i = 0; i < 1600; ++i)
+  {
+    ++buckets[hash(i * 1024) % 16];
+  }
+
+  for (auto count : buckets)
+  {
+    BOOST_CHECK(count > 50);
+    BOOST_CHECK(count < 150);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapWithSeededHasher_WhenConstructing_ThenHasherIsUsed)
+{
+  aisdi::HashMap<std::string, int, StringHash> map(8, StringHash(42));
+  map["Alice"] = 1;
+
+  BOOST_CHECK(map.hash_function().seed() == 42);
+  BOOST_CHECK(map.contains("Alice"));
+  BOOST_CHECK(map.at("Alice") == 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapWithTransparentComparator_WhenLookingUpCString_ThenKeyIsFound)
+{
+  aisdi::HashMap<std::string, int, StringHash, std::equal_to<>> map;
+  map["Alice"] = 1;
+  map["Bob"] = 2;
+
+  const char* name = "Bob";
+  BOOST_CHECK(map.find(name) != map.end());
+  BOOST_CHECK(map.count("Chuck") == 0);
+  BOOST_CHECK(map.erase("Alice") == 1);
+  BOOST_CHECK(map.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapsWithDifferentSeeds_WhenComparingAndMerging_ThenKeysAreFound)
+{
+  using Map = aisdi::HashMap<std::uint64_t, int, IntegerHash<std::uint64_t>>;
+  Map map;
+  Map other;
+  for (std::uint64_t i = 0; i < 100; ++i)
+  {
+    map[i] = static_cast<int>(i);
+    other[99 - i] = static_cast<int>(99 - i);
+  }
+
+  BOOST_CHECK(map.hash_function().seed() != other.hash_function().seed());
+  BOOST_CHECK(map == other);
+
+  Map target;
+  target.merge(map);
+  BOOST_CHECK(target == other);
+  BOOST_CHECK(map.empty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenSetWithSeededHasher_WhenInsertingKeys_ThenTheyMayBeFound)
+{
+  aisdi::HashSet<std::string, StringHash> set(8, StringHash(7));
+  set.insert("Alice");
+
+  BOOST_CHECK(set.hash_function().seed() == 7);
+  BOOST_CHECK(set.contains("Alice"));
+  BOOST_CHECK(!set.insert("Alice").second);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,388 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/IntegerHashMap.hpp"
+
+template <typename K>
+using Map = aisdi::IntegerHashMap<K, std::string>;
+
+using TestedKeyTypes = boost::mpl::list<std::uint32_t, std::int32_t, std::uint64_t>;
+
+namespace
+{
+
+template <typename K>
+K key(int value)
+{
+  return static_cast<K>(value);
+}
+
+template <typename K>
+void thenMapContainsItems(const Map<K>& map, int count)
+{
+  BOOST_REQUIRE(map.size() == static_cast<std::size_t>(count));
+  for (auto i = 0; i < count; ++i)
+  {
+    const auto pos = map.find(key<K>(i));
+    BOOST_REQUIRE(pos != map.end());
+    BOOST_CHECK(pos->first == key<K>(i));
+    BOOST_CHECK(pos->second == std::to_string(i));
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(IntegerHashMapTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenLookingUpKey_ThenItIsNotFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.size() == 0);
+  BOOST_CHECK(map.bucket_count() == 0);
+  BOOST_CHECK(map.begin() == map.end());
+  BOOST_CHECK(map.find(key<K>(42)) == map.end());
+  BOOST_CHECK(!map.contains(std::numeric_limits<K>::max()));
+  BOOST_CHECK_THROW(map.at(key<K>(42)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInitializerList_WhenCreatingMap_ThenAllItemsAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = {{key<K>(42), "Alice"}, {key<K>(27), "Bob"}, {key<K>(13), "Chuck"}};
+
+  BOOST_CHECK(map.size() == 3);
+  BOOST_CHECK(map.at(key<K>(42)) == "Alice");
+  BOOST_CHECK(map.at(key<K>(27)) == "Bob");
+  BOOST_CHECK(map.find(key<K>(13))->second == "Chuck");
+  BOOST_CHECK(map.count(key<K>(7)) == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingPresentKey_ThenItemIsNotReplaced,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  const auto first = map.insert({key<K>(42), "Alice"});
+  const auto second = map.insert({key<K>(42), "Bob"});
+
+  BOOST_CHECK(first.second);
+  BOOST_CHECK(!second.second);
+  BOOST_CHECK(second.first == first.first);
+  BOOST_CHECK(map.at(key<K>(42)) == "Alice");
+
+  map.insert_or_assign(key<K>(42), "Chuck");
+  BOOST_CHECK(map.at(key<K>(42)) == "Chuck");
+  BOOST_CHECK(map.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenConsecutiveKeys_WhenInserting_ThenTableGrowsAndAllAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 20000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  thenMapContainsItems(map, 20000);
+  BOOST_CHECK(map.load_factor() <= map.max_load_factor());
+  for (auto i = 20000; i < 25000; ++i)
+  {
+    BOOST_CHECK(!map.contains(key<K>(i)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullLoadFactor_WhenFillingTable_ThenKeysOverflowToNextGroups,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map(1);
+  map.max_load_factor(1.0f);
+  const auto bucketCount = map.bucket_count();
+
+  const auto count = static_cast<int>(bucketCount);
+  for (auto i = 0; i < count; ++i)
+  {
+    map[key<K>(3 * i)] = std::to_string(i);
+  }
+
+  BOOST_CHECK(map.bucket_count() == bucketCount);
+  BOOST_CHECK(map.load_factor() == 1.0f);
+  for (auto i = 0; i < count; ++i)
+  {
+    BOOST_CHECK(map.at(key<K>(3 * i)) == std::to_string(i));
+    BOOST_CHECK(!map.contains(key<K>(3 * i + 1)));
+  }
+
+  map[key<K>(1)] = "Alice";
+  BOOST_CHECK(map.bucket_count() > bucketCount);
+  BOOST_CHECK(map.at(key<K>(1)) == "Alice");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenIterating_ThenEveryItemIsVisitedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 1000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  std::map<K, std::string> visited;
+  for (auto pos = map.begin(); pos != map.end(); ++pos)
+  {
+    BOOST_CHECK(visited.insert(*pos).second);
+  }
+
+  BOOST_CHECK(visited.size() == 1000);
+  BOOST_CHECK(visited.at(key<K>(999)) == "999");
+
+  auto pos = map.end();
+  for (auto i = 0; i < 1000; ++i)
+  {
+    --pos;
+  }
+  BOOST_CHECK(pos == map.begin());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenAssigningValue_ThenItemIsChanged,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = {{key<K>(42), "Alice"}};
+
+  map.find(key<K>(42))->second = "Bob";
+  BOOST_CHECK(map.at(key<K>(42)) == "Bob");
+
+  (*map.begin()).second += "by";
+  BOOST_CHECK(map.at(key<K>(42)) == "Bobby");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenErasingKeys_ThenOnlyTheyAreRemoved,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 1000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  for (auto i = 0; i < 1000; i += 2)
+  {
+    BOOST_CHECK(map.erase(key<K>(i)) == 1);
+  }
+  BOOST_CHECK(map.erase(key<K>(0)) == 0);
+
+  BOOST_CHECK(map.size() == 500);
+  for (auto i = 0; i < 1000; ++i)
+  {
+    BOOST_CHECK(map.contains(key<K>(i)) == (i % 2 == 1));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenErasingWhileIterating_ThenEveryItemIsVisitedOnce,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 1000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  auto visited = std::size_t{0};
+  for (auto pos = map.begin(); pos != map.end(); ++visited)
+  {
+    pos = map.erase(pos);
+  }
+
+  BOOST_CHECK(visited == 1000);
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.begin() == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSentinelKey_WhenInsertingAndErasing_ThenItIsKeptAside,
+                              K,
+                              TestedKeyTypes)
+{
+  const auto sentinel = std::numeric_limits<K>::max();
+  Map<K> map;
+
+  map[sentinel] = "Alice";
+  map[key<K>(42)] = "Bob";
+
+  BOOST_CHECK(map.size() == 2);
+  BOOST_CHECK(map.load_factor() * static_cast<float>(map.bucket_count()) == 1.0f);
+  BOOST_CHECK(map.at(sentinel) == "Alice");
+  BOOST_CHECK(std::prev(map.end())->first == sentinel);
+
+  for (auto i = 0; i < 1000; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+  BOOST_CHECK(map.at(sentinel) == "Alice");
+
+  BOOST_CHECK(map.erase(sentinel) == 1);
+  BOOST_CHECK(!map.contains(sentinel));
+  thenMapContainsItems(map, 1000);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRandomOperations_WhenComparingWithStdMap_ThenContentsAreEqual,
+                              K,
+                              TestedKeyTypes)
+{
+  // Few distinct keys, so erasures often hit keys overflowed from full groups
+  auto engine = std::mt19937{42};
+  auto keyOf = std::uniform_int_distribution<int>{0, 300};
+  auto operation = std::uniform_int_distribution<int>{0, 2};
+
+  Map<K> map(64);
+  map.max_load_factor(1.0f);
+  std::map<K, std::string> expected;
+  for (auto i = 0; i < 20000; ++i)
+  {
+    const auto k = key<K>(keyOf(engine));
+    if (operation(engine) == 0)
+    {
+      BOOST_REQUIRE(map.erase(k) == expected.erase(k));
+    }
+    else
+    {
+      map[k] = std::to_string(i);
+      expected[k] = std::to_string(i);
+    }
+  }
+
+  BOOST_REQUIRE(map.size() == expected.size());
+  for (auto i = 0; i <= 300; ++i)
+  {
+    const auto pos = map.find(key<K>(i));
+    const auto expectedPos = expected.find(key<K>(i));
+    BOOST_REQUIRE((pos == map.end()) == (expectedPos == expected.end()));
+    if (pos != map.end())
+    {
+      BOOST_CHECK(pos->second == expectedPos->second);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenCopying_ThenCopyIsEqualAndIndependent,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+  map[std::numeric_limits<K>::max()] = "Alice";
+
+  auto copy = map;
+  BOOST_CHECK(copy == map);
+
+  copy.erase(key<K>(7));
+  copy[key<K>(8)] = "Bob";
+  BOOST_CHECK(copy != map);
+  BOOST_CHECK(map.at(key<K>(7)) == "7");
+  BOOST_CHECK(map.at(key<K>(8)) == "8");
+  BOOST_CHECK(copy.at(std::numeric_limits<K>::max()) == "Alice");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenMoving_ThenItemsAreInTargetAndSourceIsUsable,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[key<K>(i)] = std::to_string(i);
+  }
+
+  auto target = std::move(map);
+  thenMapContainsItems(target, 100);
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.find(key<K>(1)) == map.end());
+  map[key<K>(1)] = "Alice";
+  BOOST_CHECK(map.size() == 1);
+  BOOST_CHECK(map.at(key<K>(1)) == "Alice");
+}
+
+BOOST_AUTO_TEST_CASE(GivenMapsWithSameItemsInOtherOrder_WhenComparing_ThenTheyAreEqual)
+{
+  Map<std::uint32_t> lhs;
+  Map<std::uint32_t> rhs(1024);
+  for (auto i = 0u; i < 100; ++i)
+  {
+    lhs[i] = std::to_string(i);
+    rhs[99 - i] = std::to_string(99 - i);
+  }
+
+  BOOST_CHECK(lhs == rhs);
+  rhs[50] = "Alice";
+  BOOST_CHECK(lhs != rhs);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenRehashing_ThenBucketCountIsMultipleOfGroupAndItemsAreKept)
+{
+  Map<std::uint32_t> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[key<std::uint32_t>(i)] = std::to_string(i);
+  }
+
+  map.rehash(1000);
+  BOOST_CHECK(map.bucket_count() == 1024);
+  thenMapContainsItems(map, 100);
+
+  map.rehash(0);
+  BOOST_CHECK(map.bucket_count() == 128);
+  thenMapContainsItems(map, 100);
+
+  map.reserve(10000);
+  BOOST_CHECK(static_cast<float>(map.bucket_count()) * map.max_load_factor() >= 10000.0f);
+  thenMapContainsItems(map, 100);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenClearing_ThenItIsEmptyAndReusable)
+{
+  Map<std::uint32_t> map;
+  for (auto i = 0; i < 100; ++i)
+  {
+    map[key<std::uint32_t>(i)] = std::to_string(i);
+  }
+  map[std::numeric_limits<std::uint32_t>::max()] = "Alice";
+
+  const auto bucketCount = map.bucket_count();
+  map.clear();
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.begin() == map.end());
+  BOOST_CHECK(map.bucket_count() == bucketCount);
+  BOOST_CHECK(!map.contains(std::numeric_limits<std::uint32_t>::max()));
+
+  map[7] = "7";
+  BOOST_CHECK(map.at(7) == "7");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
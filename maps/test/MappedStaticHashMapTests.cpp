@@ -0,0 +1,227 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "aisdi/Hash.hpp"
+#include "aisdi/MappedStaticHashMap.hpp"
+#include "aisdi/StaticHashMap.hpp"
+
+using Map = aisdi::StaticHashMap<std::uint32_t, double>;
+using MappedMap = aisdi::MappedStaticHashMap<std::uint32_t, double>;
+
+namespace
+{
+
+struct TemporaryFile
+{
+  TemporaryFile()
+  {
+    char name[] = "/tmp/aisdi_MappedStaticHashMapTests_XXXXXX";
+    const auto fd = mkstemp(name);
+    BOOST_REQUIRE(fd >= 0);
+    close(fd);
+    path = name;
+  }
+
+  ~TemporaryFile()
+  {
+    std::remove(path.c_str());
+  }
+
+  std::string path;
+};
+
+std::vector<std::pair<std::uint32_t, double>> makeItems(std::uint32_t count)
+{
+  auto items = std::vector<std::pair<std::uint32_t, double>>{};
+  for (std::uint32_t i = 0; i < count; ++i)
+  {
+    items.emplace_back(i * 3, i / 2.0);
+  }
+  return items;
+}
+
+bool containsAll(const MappedMap& map, const std::vector<std::pair<std::uint32_t, double>>& items)
+{
+  for (const auto& item : items)
+  {
+    const auto pos = map.find(item.first);
+    if (pos == map.end() || pos->second != item.second)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(MappedStaticHashMapTests)
+
+BOOST_AUTO_TEST_CASE(GivenSavedMap_WhenMappingIt_ThenAllItemsAreFound)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(10000);
+  Map(items.begin(), items.end()).save(file.path);
+
+  const MappedMap map(file.path);
+
+  BOOST_CHECK(map.size() == items.size());
+  BOOST_CHECK(containsAll(map, items));
+  BOOST_CHECK(!map.contains(1));
+  BOOST_CHECK(map.count(4) == 0);
+  BOOST_CHECK_THROW(map.at(2), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSavedMap_WhenIteratingMappedOne_ThenItemsHaveSameOrder)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(1000);
+  const Map original(items.begin(), items.end());
+  original.save(file.path);
+
+  const MappedMap map(file.path);
+
+  auto pos = map.begin();
+  for (const auto& item : original)
+  {
+    BOOST_REQUIRE(pos != map.end());
+    BOOST_CHECK(pos->first == item.first);
+    BOOST_CHECK(pos->second == item.second);
+    ++pos;
+  }
+  BOOST_CHECK(pos == map.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyMaps_WhenSavingAndMapping_ThenNoKeyIsFound)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(0);
+
+  Map(items.begin(), items.end()).save(file.path);
+  BOOST_CHECK(MappedMap(file.path).empty());
+
+  Map().save(file.path);
+  const MappedMap map(file.path);
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.find(42) == map.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenMappedMap_WhenMovingIt_ThenItemsAreFoundInTarget)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(100);
+  Map(items.begin(), items.end()).save(file.path);
+
+  MappedMap map(file.path);
+  const auto other = std::move(map);
+
+  BOOST_CHECK(containsAll(other, items));
+}
+
+BOOST_AUTO_TEST_CASE(GivenMovedFromMap_WhenUsingIt_ThenItIsEmpty)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(100);
+  Map(items.begin(), items.end()).save(file.path);
+
+  MappedMap map(file.path);
+  MappedMap other(file.path);
+  other = std::move(map);
+  const auto target = std::move(other);
+
+  for (const MappedMap* moved : {&map, &other})
+  {
+    BOOST_CHECK(moved->empty());
+    BOOST_CHECK(moved->size() == 0);
+    BOOST_CHECK(moved->begin() == moved->end());
+    BOOST_CHECK(moved->find(3) == moved->end());
+    BOOST_CHECK(!moved->contains(3));
+    BOOST_CHECK_THROW(moved->at(3), std::out_of_range);
+  }
+  BOOST_CHECK(containsAll(target, items));
+}
+
+BOOST_AUTO_TEST_CASE(GivenMissingFile_WhenMapping_ThenSystemErrorIsThrown)
+{
+  BOOST_CHECK_THROW(MappedMap("/nonexistent/aisdi_map"), std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenInvalidFiles_WhenMapping_ThenExceptionIsThrown)
+{
+  const auto file = TemporaryFile{};
+  BOOST_CHECK_THROW(MappedMap{file.path}, std::runtime_error);
+
+  {
+    std::ofstream stream(file.path, std::ios::binary);
+    stream << std::string(200, 'x');
+  }
+  BOOST_CHECK_THROW(MappedMap{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTruncatedImage_WhenMapping_ThenExceptionIsThrown)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(1000);
+  Map(items.begin(), items.end()).save(file.path);
+
+  BOOST_REQUIRE(truncate(file.path.c_str(), 1024) == 0);
+
+  BOOST_CHECK_THROW(MappedMap{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenImageOfOtherItemType_WhenMapping_ThenExceptionIsThrown)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(10);
+  Map(items.begin(), items.end()).save(file.path);
+
+  using OtherMap = aisdi::MappedStaticHashMap<std::uint64_t, std::uint64_t>;
+  BOOST_CHECK_THROW(OtherMap{file.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenImageBuiltWithOtherSeed_WhenMapping_ThenExceptionIsThrown)
+{
+  using Hash = aisdi::IntegerHash<std::uint32_t>;
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(100);
+  aisdi::StaticHashMap<std::uint32_t, double, Hash>(items.begin(), items.end(), Hash(1))
+      .save(file.path);
+
+  using SeededMap = aisdi::MappedStaticHashMap<std::uint32_t, double, Hash>;
+  BOOST_CHECK(SeededMap(file.path, Hash(1)).contains(3));
+  BOOST_CHECK_THROW(SeededMap(file.path, Hash(2)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSavedMap_WhenMappingInOtherProcess_ThenItemsAreFoundThere)
+{
+  const auto file = TemporaryFile{};
+  const auto items = makeItems(1000);
+  Map(items.begin(), items.end()).save(file.path);
+  const MappedMap map(file.path);
+
+  const auto child = fork();
+  BOOST_REQUIRE(child >= 0);
+  if (child == 0)
+  {
+    const MappedMap childMap(file.path);
+    _exit(containsAll(childMap, items) && containsAll(map, items) ? 0 : 1);
+  }
+
+  auto status = 0;
+  BOOST_REQUIRE(waitpid(child, &status, 0) == child);
+  BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+#include <hayai.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <aisdi/ConcurrentHashMap.hpp>
+#include <aisdi/ReadMostlyHashMap.hpp>
+
+constexpr auto Size = 100000;
+constexpr auto LookupsPerThread = 100000;
+
+// Threads only look keys up, so time per iteration stays flat as long as
+// readers do not slow each other down
+template<typename Map, unsigned Threads>
+class ReaderScalingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        for(auto i = 0; i < Size; ++i)
+        {
+            container.insert_or_assign(i, i);
+        }
+    }
+
+    void run()
+    {
+        auto threads = std::vector<std::thread>{};
+        for(auto t = 0u; t < Threads; ++t)
+        {
+            threads.emplace_back([this, t]
+                {
+                    auto seed = t + 1;
+                    auto value = 0;
+                    for(auto i = 0; i < LookupsPerThread; ++i)
+                    {
+                        seed = seed * 1103515245u + 12345u;
+                        container.find(static_cast<int>((seed >> 8) % Size), value);
+                    }
+                });
+        }
+
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    Map container;
+};
+
+using ReadMostly = aisdi::ReadMostlyHashMap<int, int>;
+using Sharded = aisdi::ConcurrentHashMap<int, int>;
+
+using ReadMostly1ReaderBenchmark = ReaderScalingBenchmark<ReadMostly, 1>;
+using ReadMostly2ReadersBenchmark = ReaderScalingBenchmark<ReadMostly, 2>;
+using ReadMostly4ReadersBenchmark = ReaderScalingBenchmark<ReadMostly, 4>;
+using ReadMostly8ReadersBenchmark = ReaderScalingBenchmark<ReadMostly, 8>;
+using ReadMostly16ReadersBenchmark = ReaderScalingBenchmark<ReadMostly, 16>;
+using Sharded1ReaderBenchmark = ReaderScalingBenchmark<Sharded, 1>;
+using Sharded2ReadersBenchmark = ReaderScalingBenchmark<Sharded, 2>;
+using Sharded4ReadersBenchmark = ReaderScalingBenchmark<Sharded, 4>;
+using Sharded8ReadersBenchmark = ReaderScalingBenchmark<Sharded, 8>;
+using Sharded16ReadersBenchmark = ReaderScalingBenchmark<Sharded, 16>;
+
+BENCHMARK_F(ReadMostly1ReaderBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(ReadMostly2ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(ReadMostly4ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(ReadMostly8ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(ReadMostly16ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(Sharded1ReaderBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(Sharded2ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(Sharded4ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(Sharded8ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(Sharded16ReadersBenchmark, FindTest, 10, 1)
+{
+    run();
+}
@@ -0,0 +1,238 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "aisdi/EpochDomain.hpp"
+#include "aisdi/ReadMostlyHashMap.hpp"
+
+namespace
+{
+
+// Value, which counts its live instances and copies
+struct Counted
+{
+  Counted(int value_ = 0)
+    : value(value_)
+  {
+    ++alive;
+  }
+
+  Counted(const Counted& other)
+    : value(other.value)
+  {
+    ++alive;
+    ++copies;
+  }
+
+  Counted& operator=(const Counted&) = default;
+
+  ~Counted()
+  {
+    --alive;
+  }
+
+  int value;
+
+  static std::atomic<int> alive;
+  static std::atomic<int> copies;
+};
+
+std::atomic<int> Counted::alive{0};
+std::atomic<int> Counted::copies{0};
+
+// Hashes every key to the same value, so all keys share one chain
+struct ConstantHash
+{
+  std::size_t operator()(std::int32_t) const
+  {
+    return 42;
+  }
+};
+
+} // namespace
+
+using Map = aisdi::ReadMostlyHashMap<std::int32_t, std::string>;
+
+BOOST_AUTO_TEST_SUITE(ReadMostlyHashMapTests)
+
+BOOST_AUTO_TEST_CASE(GivenEmptyMap_WhenInsertingItems_ThenTheyMayBeFound)
+{
+  Map map;
+
+  BOOST_CHECK(map.insert_or_assign(42, "Alice"));
+  BOOST_CHECK(map.insert_or_assign(27, "Bob"));
+  BOOST_CHECK(!map.insert_or_assign(42, "Chuck"));
+
+  std::string value;
+  BOOST_CHECK(map.find(42, value));
+  BOOST_CHECK(value == "Chuck");
+  BOOST_CHECK(!map.find(13, value));
+  BOOST_CHECK(map.contains(27));
+  BOOST_CHECK(map.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenErasingItems_ThenOnlyPresentOnesAreCounted)
+{
+  Map map;
+  map.insert_or_assign(42, "Alice");
+
+  BOOST_CHECK(map.erase(42) == 1);
+  BOOST_CHECK(map.erase(42) == 0);
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(!map.contains(42));
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenVisitingKey_ThenValueIsPassed)
+{
+  Map map;
+  map.insert_or_assign(42, "Alice");
+
+  auto visited = std::string{};
+  BOOST_CHECK(map.visit(42, [&visited](const std::string& value) { visited = value; }));
+  BOOST_CHECK(!map.visit(13, [](const std::string&) { BOOST_FAIL("Missing key visited"); }));
+  BOOST_CHECK(visited == "Alice");
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollidingKeys_WhenModifyingMiddleOfChain_ThenOtherKeysAreKept)
+{
+  // Table does not grow and new keys are prepended, so the chain is 7, 6, ..., 0
+  aisdi::ReadMostlyHashMap<std::int32_t, Counted, ConstantHash> map(16);
+  for (std::int32_t i = 0; i < 8; ++i)
+  {
+    map.insert_or_assign(i, i);
+  }
+
+  // Only nodes in front of the modified one are copied, the rest is shared
+  Counted::copies = 0;
+  map.insert_or_assign(3, 42);
+  BOOST_CHECK(Counted::copies == 4);
+
+  Counted::copies = 0;
+  BOOST_CHECK(map.erase(5) == 1);
+  BOOST_CHECK(Counted::copies == 2);
+
+  BOOST_CHECK(map.size() == 7);
+  for (std::int32_t i = 0; i < 8; ++i)
+  {
+    auto value = Counted{-1};
+    BOOST_CHECK(map.find(i, value) == (i != 5));
+    if (i != 5)
+    {
+      BOOST_CHECK(value.value == ((i == 3) ? 42 : i));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyItems_WhenGrowing_ThenAllItemsAreKept)
+{
+  Map map(4);
+  for (std::int32_t i = 0; i < 1000; ++i)
+  {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+
+  BOOST_CHECK(map.bucket_count() >= 1000);
+  std::string value;
+  for (std::int32_t i = 0; i < 1000; ++i)
+  {
+    BOOST_REQUIRE(map.find(i, value));
+    BOOST_CHECK(value == std::to_string(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenUpdatedMap_WhenDestroyed_ThenNoValueIsLeaked)
+{
+  {
+    aisdi::ReadMostlyHashMap<std::int32_t, Counted> map(2);
+    for (std::int32_t i = 0; i < 100; ++i)
+    {
+      map.insert_or_assign(i, Counted{i});
+      map.insert_or_assign(i / 2, Counted{-i});
+    }
+    for (std::int32_t i = 0; i < 100; i += 3)
+    {
+      map.erase(i);
+    }
+  }
+
+  BOOST_CHECK(Counted::alive == 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPinnedDomain_WhenCollecting_ThenRetiredObjectIsKept)
+{
+  aisdi::EpochDomain domain;
+  {
+    const auto guard = domain.pin();
+    domain.retire(new Counted{42});
+    domain.collect();
+    domain.collect();
+    domain.collect();
+
+    BOOST_CHECK(domain.retired_count() == 1);
+    BOOST_CHECK(Counted::alive == 1);
+  }
+
+  domain.collect();
+  domain.collect();
+  domain.collect();
+
+  BOOST_CHECK(domain.retired_count() == 0);
+  BOOST_CHECK(Counted::alive == 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenReadersAndWriter_WhenRunningConcurrently_ThenReadersSeeConsistentValues)
+{
+  Map map(4);
+  for (std::int32_t i = 0; i < 100; ++i)
+  {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistentReads{0};
+  std::vector<std::thread> readers;
+  for (auto t = 0; t < 4; ++t)
+  {
+    readers.emplace_back([&]
+                         {
+                           std::string value;
+                           while (!done)
+                           {
+                             for (std::int32_t i = 0; i < 200; ++i)
+                             {
+                               if (map.find(i, value) && value != std::to_string(i)
+                                   && value != std::to_string(-i))
+                               {
+                                 ++inconsistentReads;
+                               }
+                             }
+                           }
+                         });
+  }
+
+  for (auto round = 0; round < 100; ++round)
+  {
+    for (std::int32_t i = 0; i < 200; ++i)
+    {
+      map.insert_or_assign(i, std::to_string(round % 2 == 0 ? -i : i));
+      if (i % 7 == round % 7)
+      {
+        map.erase(i);
+      }
+    }
+  }
+  done = true;
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+
+  BOOST_CHECK(inconsistentReads == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+#include <hayai.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <aisdi/HashMap.hpp>
+#include <aisdi/MappedStaticHashMap.hpp>
+#include <aisdi/StaticHashMap.hpp>
+
+constexpr auto Size = 10000000;
+constexpr auto Lookups = 1000000;
+
+using Item = std::pair<std::uint64_t, std::uint64_t>;
+using Static = aisdi::StaticHashMap<std::uint64_t, std::uint64_t>;
+using Dynamic = aisdi::HashMap<std::uint64_t, std::uint64_t>;
+using Mapped = aisdi::MappedStaticHashMap<std::uint64_t, std::uint64_t>;
+
+// Random keys, shared by all benchmarks
+const std::vector<Item>& items()
+{
+    static const auto items = []
+        {
+            auto engine = std::mt19937_64{};
+            auto items = std::vector<Item>{};
+            items.reserve(Size);
+            for(auto i = 0; i < Size; ++i)
+            {
+                items.emplace_back(engine(), i);
+            }
+            return items;
+        }();
+    return items;
+}
+
+class BuildingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        items();
+    }
+};
+
+BENCHMARK_F(BuildingBenchmark, StaticHashMapTest, 3, 1)
+{
+    const auto map = Static(items().begin(), items().end());
+    static_cast<void>(map);
+}
+
+BENCHMARK_F(BuildingBenchmark, HashMapTest, 3, 1)
+{
+    auto map = Dynamic{};
+    map.reserve(Size);
+    for(const auto& item : items())
+    {
+        map.insert(item);
+    }
+}
+
+// Present keys in random order, so nearly every lookup misses cache
+template<typename Map>
+class SearchingBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        map();
+        if(keys.empty())
+        {
+            auto engine = std::mt19937_64{42};
+            auto index = std::uniform_int_distribution<std::size_t>{0, Size - 1};
+            for(auto i = 0; i < Lookups; ++i)
+            {
+                keys.push_back(items()[index(engine)].first);
+            }
+        }
+    }
+
+    static const Map& map()
+    {
+        static const auto map = Map(items().begin(), items().end());
+        return map;
+    }
+
+    void run()
+    {
+        auto sum = std::uint64_t{0};
+        for(auto key : keys)
+        {
+            sum += map().find(key)->second;
+        }
+        result = sum;
+    }
+
+    std::vector<std::uint64_t> keys;
+    std::uint64_t result = 0;
+};
+
+using StaticSearchingBenchmark = SearchingBenchmark<Static>;
+using DynamicSearchingBenchmark = SearchingBenchmark<Dynamic>;
+
+BENCHMARK_F(StaticSearchingBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+BENCHMARK_F(DynamicSearchingBenchmark, FindTest, 10, 1)
+{
+    run();
+}
+
+// Image of the static map, saved once for all benchmarks and removed at exit
+const std::string& imagePath()
+{
+    static const struct Image
+    {
+        Image()
+        {
+            Static(items().begin(), items().end()).save(path);
+        }
+
+        ~Image()
+        {
+            std::remove(path.c_str());
+        }
+
+        std::string path = "/tmp/aisdi_StaticHashMapBenchmark.image";
+    } image;
+    return image.path;
+}
+
+// Mapping does not read items, so it takes the same time for any size
+class OpeningBenchmark
+    :   public ::hayai::Fixture
+{
+public:
+    void SetUp() override
+    {
+        imagePath();
+    }
+};
+
+BENCHMARK_F(OpeningBenchmark, OpenTest, 10, 100)
+{
+    const auto map = Mapped(imagePath());
+    static_cast<void>(map);
+}
+
+template<>
+const Mapped& SearchingBenchmark<Mapped>::map()
+{
+    static const auto map = Mapped(imagePath());
+    return map;
+}
+
+using MappedSearchingBenchmark = SearchingBenchmark<Mapped>;
+
+BENCHMARK_F(MappedSearchingBenchmark, FindTest, 10, 1)
+{
+    run();
+}
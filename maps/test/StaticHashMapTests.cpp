@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "aisdi/StaticHashMap.hpp"
+
+template <typename K>
+using Map = aisdi::StaticHashMap<K, std::string>;
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t, std::string>;
+
+namespace
+{
+
+template <typename K>
+K key(int value)
+{
+  return static_cast<K>(value);
+}
+
+template <>
+std::string key<std::string>(int value)
+{
+  return std::to_string(value);
+}
+
+template <typename K>
+std::vector<std::pair<K, std::string>> makeItems(int count)
+{
+  auto items = std::vector<std::pair<K, std::string>>{};
+  for (auto i = 0; i < count; ++i)
+  {
+    items.emplace_back(key<K>(i * 7), std::to_string(i));
+  }
+  return items;
+}
+
+// Hashes every key to the same value
+struct ConstantHash
+{
+  std::size_t operator()(int) const
+  {
+    return 42;
+  }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(StaticHashMapTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyRange_WhenBuildingMap_ThenNoKeyIsFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const auto items = makeItems<K>(0);
+  const Map<K> map(items.begin(), items.end());
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.size() == 0);
+  BOOST_CHECK(map.begin() == map.end());
+  BOOST_CHECK(map.find(key<K>(42)) == map.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenDefaultMap_WhenLookingUpKey_ThenItIsNotFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(!map.contains(key<K>(42)));
+  BOOST_CHECK_THROW(map.at(key<K>(42)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInitializerList_WhenBuildingMap_ThenAllKeysAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = {{key<K>(42), "Alice"}, {key<K>(27), "Bob"}, {key<K>(13), "Chuck"}};
+
+  BOOST_CHECK(map.size() == 3);
+  BOOST_CHECK(map.at(key<K>(42)) == "Alice");
+  BOOST_CHECK(map.at(key<K>(27)) == "Bob");
+  BOOST_CHECK(map.find(key<K>(13))->second == "Chuck");
+  BOOST_CHECK(map.count(key<K>(7)) == 0);
+  BOOST_CHECK_THROW(map.at(key<K>(7)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRepeatedKeys_WhenBuildingMap_ThenLastItemIsKept,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map = {{key<K>(42), "Alice"}, {key<K>(27), "Bob"}, {key<K>(42), "Chuck"}};
+
+  BOOST_CHECK(map.size() == 2);
+  BOOST_CHECK(map.at(key<K>(42)) == "Chuck");
+  BOOST_CHECK(map.at(key<K>(27)) == "Bob");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyKeys_WhenBuildingMap_ThenEveryItemTakesOneSlot,
+                              K,
+                              TestedKeyTypes)
+{
+  const auto items = makeItems<K>(20000);
+  const Map<K> map(items.begin(), items.end());
+
+  BOOST_CHECK(map.size() == items.size());
+  BOOST_CHECK(static_cast<std::size_t>(std::distance(map.begin(), map.end())) == items.size());
+
+  auto keys = std::set<K>{};
+  for (const auto& item : map)
+  {
+    keys.insert(item.first);
+  }
+  BOOST_CHECK(keys.size() == items.size());
+
+  for (const auto& item : items)
+  {
+    const auto pos = map.find(item.first);
+    BOOST_REQUIRE(pos != map.end());
+    BOOST_CHECK(pos->second == item.second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenManyKeys_WhenLookingUpMissingKeys_ThenTheyAreNotFound,
+                              K,
+                              TestedKeyTypes)
+{
+  const auto items = makeItems<K>(20000);
+  const Map<K> map(items.begin(), items.end());
+
+  for (auto i = 0; i < 20000; ++i)
+  {
+    BOOST_CHECK(!map.contains(key<K>(i * 7 + 3)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyKeys_WhenBuildingMap_ThenHashFunctionTakesBelowBytePerKey)
+{
+  const auto items = makeItems<std::uint64_t>(100000);
+  const Map<std::uint64_t> map(items.begin(), items.end());
+
+  BOOST_CHECK(map.function_bytes() < items.size());
+}
+
+BOOST_AUTO_TEST_CASE(GivenDistinctKeysWithEqualHashes_WhenBuildingMap_ThenExceptionIsThrown)
+{
+  const auto items = std::vector<std::pair<int, int>>{{1, 1}, {2, 2}};
+
+  using CollidingMap = aisdi::StaticHashMap<int, int, ConstantHash>;
+  BOOST_CHECK_THROW(CollidingMap(items.begin(), items.end()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSingleKeyWithConstantHash_WhenBuildingMap_ThenItIsFound)
+{
+  const aisdi::StaticHashMap<int, int, ConstantHash> map = {{1, 1}, {1, 2}};
+
+  BOOST_CHECK(map.size() == 1);
+  BOOST_CHECK(map.at(1) == 2);
+  BOOST_CHECK(!map.contains(2));
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenCopying_ThenCopyFindsSameItems)
+{
+  const auto items = makeItems<std::string>(1000);
+  const Map<std::string> map(items.begin(), items.end());
+
+  const auto copy = map;
+
+  BOOST_CHECK(copy.size() == map.size());
+  for (const auto& item : items)
+  {
+    BOOST_CHECK(copy.at(item.first) == item.second);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,3 +1,6 @@
+#include <cstring>
+#include <string>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
 
@@ -87,6 +90,43 @@ struct Fixture
   }
 };
 
+// Key, which counts its constructions
+struct Name
+{
+  Name(const char* value_)
+    : value(value_)
+  {
+    ++created;
+  }
+
+  std::string value;
+
+  static std::size_t created;
+};
+
+std::size_t Name::created = 0;
+
+const char* chars(const Name& name)
+{
+  return name.value.c_str();
+}
+
+const char* chars(const char* name)
+{
+  return name;
+}
+
+struct TransparentNameLess
+{
+  using is_transparent = void;
+
+  template <typename L, typename R>
+  bool operator()(const L& lhs, const R& rhs) const
+  {
+    return std::strcmp(chars(lhs), chars(rhs)) < 0;
+  }
+};
+
 } // namespace
 
 template <typename K>
@@ -771,4 +811,113 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_Th
   BOOST_CHECK(map != other);
 }
 
+BOOST_AUTO_TEST_CASE(GivenTransparentCompare_WhenLookingUpByOtherType_ThenNoKeyIsConstructed)
+{
+  aisdi::TreeMap<Name, int, TransparentNameLess> map;
+  map[Name("Bob")] = 2;
+  map[Name("Alice")] = 1;
+  map[Name("Chuck")] = 3;
+  Name::created = 0;
+
+  BOOST_REQUIRE(map.find("Bob") != map.end());
+  BOOST_CHECK(map.find("Bob")->second == 2);
+  BOOST_CHECK(map.find("Dave") == map.end());
+  BOOST_CHECK(map.contains("Alice"));
+  BOOST_CHECK(map.count("Chuck") == 1);
+  BOOST_CHECK(map.count("Dave") == 0);
+  BOOST_CHECK(map.at("Chuck") == 3);
+  BOOST_CHECK_THROW(map.at("Dave"), std::logic_error);
+
+  const auto& constMap = map;
+  BOOST_CHECK(constMap.find("Alice")->second == 1);
+  BOOST_CHECK(constMap.at("Alice") == 1);
+
+  BOOST_CHECK(map.erase("Alice") == 1);
+  BOOST_CHECK(map.erase("Alice") == 0);
+  BOOST_CHECK(Name::created == 0);
+
+  map.erase(map.begin());
+  BOOST_CHECK(map.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenExtractingKey_ThenNodeHoldsItsItem,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" }, { 13, "Chuck" } };
+
+  auto node = map.extract(27);
+
+  BOOST_REQUIRE(!node.empty());
+  BOOST_CHECK(node.key() == K{27});
+  BOOST_CHECK(node.mapped() == "Bob");
+  BOOST_CHECK(!map.contains(27));
+  BOOST_CHECK(map.size() == 2);
+  BOOST_CHECK(map.extract(7).empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenExtractedNode_WhenInsertingIntoOtherMap_ThenItemIsNotCopied,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+  Map<K> other = { { 13, "Chuck" } };
+  auto node = map.extract(map.begin());
+  OperationCountingObject::resetCounters();
+
+  const auto result = other.insert(std::move(node));
+
+  BOOST_CHECK(result.inserted);
+  BOOST_CHECK(result.node.empty());
+  BOOST_CHECK(result.position->second == "Bob");
+  BOOST_CHECK(other.size() == 2);
+  BOOST_CHECK(OperationCountingObject::constructedObjects == 0);
+  BOOST_CHECK(OperationCountingObject::destroyedObjects == 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNodeWithPresentKey_WhenInsertingIt_ThenNodeIsGivenBack,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" } };
+  Map<K> other = { { 42, "Bob" } };
+
+  const auto result = map.insert(other.extract(42));
+
+  BOOST_CHECK(!result.inserted);
+  BOOST_REQUIRE(!result.node.empty());
+  BOOST_CHECK(result.node.mapped() == "Bob");
+  BOOST_CHECK(result.position->second == "Alice");
+  BOOST_CHECK(other.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMaps_WhenMerging_ThenOnlyMissingKeysAreMovedInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  Map<K> other;
+  for (int i = 0; i < 20; ++i)
+  {
+    map[K((i * 7) % 20)] = "Alice";
+    other[K((i * 7) % 20 + 10)] = "Bob";
+  }
+  OperationCountingObject::resetCounters();
+
+  map.merge(other);
+
+  BOOST_CHECK(map.size() == 30);
+  BOOST_CHECK(other.size() == 10);
+  auto expected = 0;
+  for (const auto& item : map)
+  {
+    BOOST_CHECK(item.first == K(expected));
+    BOOST_CHECK(item.second == (expected < 20 ? "Alice" : "Bob"));
+    ++expected;
+  }
+  BOOST_CHECK(other.begin()->first == K{10});
+  BOOST_CHECK(OperationCountingObject::copiedObjects == 0);
+  BOOST_CHECK(OperationCountingObject::movedObjects == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
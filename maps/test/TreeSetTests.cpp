@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "aisdi/TreeSet.hpp"
+
+using Set = aisdi::TreeSet<std::int32_t>;
+
+BOOST_AUTO_TEST_SUITE(TreeSetTests)
+
+BOOST_AUTO_TEST_CASE(GivenEmptySet_WhenInsertingKey_ThenItIsReportedAsNew)
+{
+  Set set;
+
+  const auto result = set.insert(42);
+
+  BOOST_CHECK(result.second);
+  BOOST_CHECK(*result.first == 42);
+  BOOST_CHECK(set.contains(42));
+  BOOST_CHECK(set.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSetWithKey_WhenInsertingItAgain_ThenExistingKeyIsReturned)
+{
+  Set set;
+  const auto pos = set.insert(42).first;
+
+  const auto result = set.insert(42);
+
+  BOOST_CHECK(!result.second);
+  BOOST_CHECK(result.first == pos);
+  BOOST_CHECK(set.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenUnorderedKeys_WhenIterating_ThenKeysAreSorted)
+{
+  const Set set{5, 3, 8, 1, 4, 7, 9};
+
+  const std::vector<std::int32_t> keys(set.begin(), set.end());
+
+  BOOST_CHECK((keys == std::vector<std::int32_t>{1, 3, 4, 5, 7, 8, 9}));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSet_WhenErasingKey_ThenItIsNoLongerFound)
+{
+  Set set{1, 2, 3};
+
+  BOOST_CHECK(set.erase(2) == 1);
+  BOOST_CHECK(set.erase(2) == 0);
+  BOOST_CHECK(!set.contains(2));
+  BOOST_CHECK(set.count(3) == 1);
+  BOOST_CHECK(set.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSet_WhenCopying_ThenCopyIsEqual)
+{
+  Set set{1, 2, 3};
+
+  const Set copy{set};
+  BOOST_CHECK(copy == set);
+
+  set.insert(4);
+  BOOST_CHECK(copy != set);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStringKeys_WhenLookingUpTransparently_ThenNoKeyIsConstructed)
+{
+  aisdi::TreeSet<std::string, std::less<>> set{"Alice", "Bob"};
+
+  BOOST_CHECK(set.contains("Alice"));
+  BOOST_CHECK(set.find("Chuck") == set.end());
+  BOOST_CHECK(set.erase("Bob") == 1);
+  BOOST_CHECK(set.size() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()